@@ -0,0 +1,532 @@
+// ======================================================================
+// ============== TSP_bench : micro-benchmarks sans Gurobi ==============
+// ======================================================================
+// noyaux mesures : lecture instance (ATSPDataC), findSubtour_S,
+// findFractionalCut_S, directed_min_cut (balayage 0 -> tous les puits) et sa version
+// CSR pushRelabel:csr (verifiee identique : valeurs + cotes puits), la meme sur une suite de
+// points (rounds CUT_LP) a froid / a chaud (pushRelabel:warm, flots repris d'un point a l'autre),
+// findLiftedCycles (D_k+/-), findSymFractionalCut_S (Stoer-Wagner) et findCombs
+// sur les instances symetriques, distanceRow (scalaire / avx2) et
+// nearestNeighborGraph (k-d tree, k == 10) sur les instances a coordonnees,
+// Held-Karp sur les petites instances (n <= 20), borne 1-arborescence (n <= 1000, + ligne BOUND :
+// upper, arcs elimines par couts reduits),
+// relaxation d'affectation (hongroise, n <= 2000), updateWeight (reoptimisation, verifie sur u16 / i32 / i64)
+//
+// usage : TSP_bench [--reps N] [--warmup N] [--json] [--points FILE]... [instances...]
+//   instances : fichiers TSPLIB (ex. data/ftv70.atsp, data_git/pr439.tsp)
+//   --points  : points LP enregistres par "TSP_Gurobi inst CUT_LP --dump-points FILE"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ATSP_Bound.hpp"
+#include "ATSP_Data.hpp"
+#include "ATSP_HeldKarp.hpp"
+#include "ATSP_MaxFlow.hpp"
+#include "ATSP_Neighbors.hpp"
+#include "ATSP_Sep.hpp"
+#include "ATSP_Stats.hpp"
+#include "hi_pr.hpp"
+
+using namespace std;
+
+struct BenchConfig{
+    int reps = 20;
+    int warmup = 3;
+    bool json = false;
+};
+
+static volatile double benchSink = 0.0; // empeche l'elimination des appels
+
+// --------------- MESURE --------------- 
+struct BenchResult{
+    string kernel;
+    string input;
+    int n;
+    long long calls; // appels du noyau par repetition
+    vector<double> us; // temps par repetition (micro-secondes)
+};
+
+static double percentile(vector<double> v, double p){
+    if (v.empty())
+        {return 0.0;}
+    sort(v.begin(), v.end());
+    size_t rank = static_cast<size_t>(p * (v.size() - 1) + 0.5); // rang le plus proche
+    return v[min(rank, v.size() - 1)];
+}
+
+static BenchResult runBench(const BenchConfig &cfg, const string &kernel, const string &input, int n,
+                            long long calls, const function<double()> &fn){
+    BenchResult res{kernel, input, n, calls, {}};
+    for (int r = 0; r < cfg.warmup; ++r)
+        {benchSink = benchSink + fn();}
+
+    res.us.reserve(cfg.reps);
+    for (int r = 0; r < cfg.reps; ++r){
+        long long start = nowNs();
+        benchSink = benchSink + fn();
+        res.us.push_back((nowNs() - start) * 1e-3);
+    }
+    return res;
+}
+
+static void printResult(const BenchConfig &cfg, const BenchResult &res){
+    double mean = 0.0;
+    for (double t : res.us)
+        {mean += t;}
+    mean = res.us.empty() ? 0.0 : mean / res.us.size();
+
+    double med = percentile(res.us, 0.5);
+    double p95 = percentile(res.us, 0.95);
+    double best = res.us.empty() ? 0.0 : *min_element(res.us.begin(), res.us.end());
+
+    if (cfg.json){
+        cout << "{\"kernel\":\"" << res.kernel << "\",\"input\":\"" << res.input << "\""
+             << ",\"n\":" << res.n << ",\"calls\":" << res.calls << ",\"reps\":" << res.us.size()
+             << ",\"median_us\":" << med << ",\"p95_us\":" << p95
+             << ",\"min_us\":" << best << ",\"mean_us\":" << mean << "}" << endl;
+    }
+    else{
+        cout << "BENCH kernel=" << res.kernel << " input=" << res.input << " n=" << res.n
+             << " calls=" << res.calls << " reps=" << res.us.size()
+             << " median_us=" << med << " p95_us=" << p95
+             << " min_us=" << best << " mean_us=" << mean << endl;
+    }
+}
+
+// --------------- POINTS SYNTHETIQUES --------------- 
+// tour plus proche voisin depuis 0 (ordre de visite)
+template <typename Matrix>
+static vector<int> nearestNeighborTourT(const Matrix &D, int n){
+    vector<int> tour;
+    vector<bool> used(n, false);
+    int cur = 0;
+    used[0] = true;
+    tour.push_back(0);
+    for (int k = 1; k < n; ++k){
+        int best = -1;
+        for (int j = 0; j < n; ++j){
+            if (!used[j] && (best < 0 || D(cur, j) < D(cur, best)))
+                {best = j;}
+        }
+        used[best] = true;
+        tour.push_back(best);
+        cur = best;
+    }
+    return tour;
+}
+
+static vector<int> nearestNeighborTour(const ATSPDataC &data){
+    return data.visit([&](const auto &D) { return nearestNeighborTourT(D, data.size); });
+}
+
+// ajoute w * (couverture par cycles de l'ordre decoupe en blocs de taille block)
+static void addCycleCover(vector<vector<double>> &sol, const vector<int> &order, int block, double w){
+    int n = static_cast<int>(order.size());
+    for (int s = 0; s < n; s += block){
+        int e = min(n, s + block);
+        if (n - e < 2)
+            {e = n;} // pas de bloc de taille 1 en fin
+        for (int k = s; k < e; ++k){
+            int next = (k + 1 < e) ? k + 1 : s;
+            sol[order[k]][order[next]] += w;
+        }
+        if (e == n)
+            {break;}
+    }
+}
+
+// ordre pseudo-aleatoire deterministe (LCG) de 0..n-1 avec 0 en tete
+static vector<int> shuffledOrder(int n, unsigned seed){
+    vector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        {order[i] = i;}
+    for (int i = n - 1; i > 1; --i){
+        seed = seed * 1103515245u + 12345u;
+        int j = 1 + static_cast<int>((seed >> 8) % i);
+        swap(order[i], order[j]);
+    }
+    return order;
+}
+
+// --------------- NOYAUX --------------- 
+static double sweepMinCut(const vector<vector<double>> &sol){
+    int n = static_cast<int>(sol.size());
+    vector<double> flat(static_cast<size_t>(n) * n, 0.0);
+    vector<double *> rows(n);
+    for (int i = 0; i < n; ++i){
+        rows[i] = flat.data() + static_cast<size_t>(i) * n;
+        for (int j = 0; j < n; ++j)
+            {rows[i][j] = (i == j) ? 0.0 : sol[i][j];}
+    }
+    double **cap = rows.data();
+
+    vector<long> distBuf(n);
+    long *dist = distBuf.data();
+    double total = 0.0;
+    for (int sink = 1; sink < n; ++sink){
+        double val = 0.0;
+        directed_min_cut(cap, n, 0, sink, val, dist);
+        total += val;
+    }
+    return total;
+}
+
+// meme balayage sur le graphe CSR (construit 1 fois)
+static double sweepPushRelabel(const vector<vector<double>> &sol){
+    int n = static_cast<int>(sol.size());
+    PushRelabel flow;
+    flow.build(sol);
+    double total = 0.0;
+    for (int sink = 1; sink < n; ++sink)
+        {total += flow.minCut(0, sink);}
+    return total;
+}
+
+// valeurs et cotes puits identiques a hi_pr pour chaque puits ; renvoie le nb de puits en desaccord
+static int checkPushRelabel(const vector<vector<double>> &sol){
+    int n = static_cast<int>(sol.size());
+    vector<double> flat(static_cast<size_t>(n) * n, 0.0);
+    vector<double *> rows(n);
+    for (int i = 0; i < n; ++i){
+        rows[i] = flat.data() + static_cast<size_t>(i) * n;
+        for (int j = 0; j < n; ++j)
+            {rows[i][j] = (i == j) ? 0.0 : sol[i][j];}
+    }
+    double **cap = rows.data();
+    vector<long> distBuf(n);
+    long *dist = distBuf.data();
+
+    PushRelabel flow;
+    flow.build(sol);
+    int bad = 0;
+    for (int sink = 1; sink < n; ++sink){
+        double val = 0.0;
+        directed_min_cut(cap, n, 0, sink, val, dist);
+        bool same = fabs(flow.minCut(0, sink) - val) <= 1e-9;
+        for (int v = 0; v < n && same; ++v)
+            {same = (dist[v] <= n - 1) == flow.inSinkSide(v);}
+        bad += !same;
+    }
+    return bad;
+}
+
+// suite de points (rounds successifs) : balayage complet de chaque point, a froid ou a chaud
+static double sweepRounds(const vector<vector<vector<double>>> &rounds, bool warm){
+    double total = 0.0;
+    PushRelabel cold;
+    WarmMinCut flow;
+    for (const vector<vector<double>> &sol : rounds){
+        int n = static_cast<int>(sol.size());
+        if (warm){
+            flow.build(sol);
+            for (int sink = 1; sink < n; ++sink)
+                {total += flow.minCut(0, sink);}
+        }
+        else{
+            cold.build(sol);
+            for (int sink = 1; sink < n; ++sink)
+                {total += cold.minCut(0, sink);}
+        }
+    }
+    return total;
+}
+
+// a chaud == a froid (valeurs + cotes puits) ; renvoie le nb de puits en desaccord
+static int checkWarmRounds(const vector<vector<vector<double>>> &rounds){
+    PushRelabel cold;
+    WarmMinCut flow;
+    int bad = 0;
+    for (const vector<vector<double>> &sol : rounds){
+        int n = static_cast<int>(sol.size());
+        cold.build(sol);
+        flow.build(sol);
+        for (int sink = 1; sink < n; ++sink){
+            bool same = fabs(cold.minCut(0, sink) - flow.minCut(0, sink)) <= 1e-9;
+            for (int v = 0; v < n && same; ++v)
+                {same = cold.inSinkSide(v) == flow.inSinkSide(v);}
+            bad += !same;
+        }
+    }
+    return bad;
+}
+
+static void benchRounds(const BenchConfig &cfg, const string &label, const vector<vector<vector<double>>> &rounds){
+    if (rounds.size() < 2)
+        {return;}
+    int n = static_cast<int>(rounds[0].size());
+    long long calls = 0;
+    for (const vector<vector<double>> &sol : rounds)
+        {calls += static_cast<long long>(sol.size()) - 1;}
+
+    printResult(cfg, runBench(cfg, "pushRelabel:csr", label, n, calls,
+                              [&]() { return sweepRounds(rounds, false); }));
+    printResult(cfg, runBench(cfg, "pushRelabel:warm", label, n, calls,
+                              [&]() { return sweepRounds(rounds, true); }));
+    int bad = checkWarmRounds(rounds);
+    if (bad > 0)
+        {cerr << "pushRelabel:warm != pushRelabel:csr sur " << label << " : " << bad << " puits" << endl;}
+}
+
+static void benchPoint(const BenchConfig &cfg, const string &label, const vector<vector<double>> &sol){
+    int n = static_cast<int>(sol.size());
+
+    printResult(cfg, runBench(cfg, "directed_min_cut", label, n, n - 1,
+                              [&]() { return sweepMinCut(sol); }));
+    printResult(cfg, runBench(cfg, "pushRelabel:csr", label, n, n - 1,
+                              [&]() { return sweepPushRelabel(sol); }));
+    int bad = checkPushRelabel(sol);
+    if (bad > 0)
+        {cerr << "pushRelabel:csr != directed_min_cut sur " << label << " : " << bad << " puits" << endl;}
+
+    printResult(cfg, runBench(cfg, "findFractionalCut_S", label, n, 1, [&]() {
+        vector<int> S;
+        return findFractionalCut_S(sol, S) ? static_cast<double>(S.size()) : 0.0;
+    }));
+
+    printResult(cfg, runBench(cfg, "findLiftedCycles", label, n, 1, [&]() {
+        vector<LiftedCycle> cuts;
+        return static_cast<double>(findLiftedCycles(sol, cuts));
+    }));
+}
+
+// --------------- MISE A JOUR DES COUTS (--reopt) --------------- 
+// updateWeight sur la matrice en u16, i32 et i64 (1 arc hors type) : dans le type courant puis elargissements
+// u16 -> i32 -> i64 ; dist() == matrice attendue apres chaque ecriture ; renvoie le nb d'ecarts
+static int checkUpdateWeight(const ATSPDataC &data){
+    int n = data.size;
+    vector<long long> base(static_cast<size_t>(n) * n);
+    for (int i = 0; i < n; ++i)
+        {for (int j = 0; j < n; ++j) base[static_cast<size_t>(i) * n + j] = data.dist(i, j);}
+
+    const ArcCost updates[] = {{0, 1, 7}, {1, 0, 0}, {1, 2, 70000}, {2, 1, -3}, {2, 0, 5000000000LL}, {0, 2, 11}};
+    int bad = 0;
+    for (long long wide : {-1LL, 70000LL, 5000000000LL}){ // -1 == matrice lue telle quelle (u16 sur data/)
+        vector<long long> w = base;
+        ATSPDataC d = data;
+        if (wide >= 0){
+            d.updateWeight(n - 1, 0, wide); // arc (n-1, 0) hors u16 => matrice de depart en i32 / i64
+            w[static_cast<size_t>(n - 1) * n] = wide;
+        }
+        for (const ArcCost &c : updates){
+            WeightType before = d.weightType;
+            d.updateWeight(c.i, c.j, c.cost);
+            w[static_cast<size_t>(c.i) * n + c.j] = c.cost;
+            for (size_t k = 0; k < w.size(); ++k)
+                {bad += (k % (n + 1) != 0) && d.dist(static_cast<int>(k / n), static_cast<int>(k % n)) != w[k];}
+            bad += d.weightType < before; // jamais reduit
+        }
+        bad += d.weightType != WeightType::Int64;
+    }
+    return bad;
+}
+
+static void benchInstance(const BenchConfig &cfg, const string &path){
+    ATSPDataC data(path);
+    if (data.size <= 2){
+        cerr << "skip " << path << " (lecture impossible)" << endl;
+        return;
+    }
+    int n = data.size;
+    string label = path.substr(path.find_last_of("/\\") + 1);
+
+    printResult(cfg, runBench(cfg, "parse", label, n, 1, [&]() {
+        ATSPDataC d(path);
+        return static_cast<double>(d.size);
+    }));
+
+    // 1 ligne de distances par sommet vers n candidats en ordre quelconque (gather) => n * n distances
+    if (!data.coords.empty()){
+        vector<int> cand = shuffledOrder(n, 777u);
+        vector<int32_t> out(n);
+        vector<DistanceKernel> kernels = {DistanceKernel::Scalar};
+        if (activeDistanceKernel() == DistanceKernel::Avx2)
+            {kernels.push_back(DistanceKernel::Avx2);}
+        for (DistanceKernel k : kernels){
+            printResult(cfg, runBench(cfg, string("distanceRow:") + distanceKernelName(k), label, n, n, [&]() {
+                long long sum = 0;
+                for (int i = 0; i < n; ++i){
+                    distanceRow(data.coords, i, cand.data(), n, out.data(), k);
+                    sum += out[i];
+                }
+                return static_cast<double>(sum);
+            }));
+        }
+        printResult(cfg, runBench(cfg, "nearestNeighborGraph:k10", label, n, 1, [&]() {
+            return static_cast<double>(nearestNeighborGraph(data.coords, 10).arcs());
+        }));
+    }
+
+    if (n > 2){
+        int bad = checkUpdateWeight(data);
+        if (bad > 0)
+            {cerr << "updateWeight != matrice attendue sur " << label << " : " << bad << " ecarts" << endl;}
+        ATSPDataC copy = data;
+        printResult(cfg, runBench(cfg, "updateWeight", label, n, n, [&]() {
+            for (int i = 0; i < n; ++i)
+                {copy.updateWeight(i, (i + 1) % n, data.dist(i, (i + 1) % n) + 1);}
+            return static_cast<double>(copy.dist(0, 1));
+        }));
+    }
+
+    if (n <= 20){
+        SolverParams params;
+        params.threads = 1;
+        printResult(cfg, runBench(cfg, "heldKarp", label, n, 1, [&]() {
+            ATSP_HeldKarp hk(data);
+            hk.setterParams(params);
+            hk.solve();
+            return static_cast<double>(hk.getterCost());
+        }));
+    }
+
+    // sous gradient complet (matrices denses n x n par iteration)
+    if (n <= 1000){
+        printResult(cfg, runBench(cfg, "arborescenceBound", label, n, 1, [&]() {
+            return arborescenceBound(data).bound;
+        }));
+        // qualite : tour de upper verifie, arcs elimines par couts reduits
+        LagrangianBound lb = arborescenceBound(data);
+        long long len = 0, removed = 0;
+        vector<char> seen(n, 0);
+        for (size_t t = 0; t < lb.tour.size(); ++t){
+            len += data.dist(lb.tour[t], lb.tour[(t + 1) % lb.tour.size()]);
+            seen[lb.tour[t]] = 1;
+        }
+        if (lb.tour.size() != static_cast<size_t>(n) || count(seen.begin(), seen.end(), 1) != n || len != lb.upper)
+            {cerr << "arborescenceBound : tour de upper invalide sur " << label << endl;}
+        reducedCostArcs(lb, n, removed);
+        if (cfg.json){
+            cout << "{\"bound\":\"arborescenceBound\",\"input\":\"" << label << "\",\"n\":" << n
+                 << ",\"lower\":" << lb.bound << ",\"upper\":" << lb.upper << ",\"iterations\":" << lb.iterations
+                 << ",\"arcs_elim\":" << removed << ",\"arcs\":" << static_cast<long long>(n) * (n - 1) << "}" << endl;
+        }
+        else{
+            cout << "BOUND kernel=arborescenceBound input=" << label << " n=" << n << " lower=" << lb.bound
+                 << " upper=" << lb.upper << " iterations=" << lb.iterations
+                 << " arcs_elim=" << removed << "/" << static_cast<long long>(n) * (n - 1) << endl;
+        }
+    }
+    if (n <= 2000){
+        printResult(cfg, runBench(cfg, "assignmentBound", label, n, 1, [&]() {
+            return static_cast<double>(assignmentBound(data).value);
+        }));
+    }
+
+    vector<int> tour = nearestNeighborTour(data);
+    vector<int> reversed(tour.rbegin(), tour.rend());
+    vector<int> shuffled = shuffledOrder(n, 12345u);
+
+    // point entier avec sous tours (4 blocs) => findSubtour_S
+    vector<vector<double>> integral(n, vector<double>(n, 0.0));
+    addCycleCover(integral, tour, max(2, n / 4), 1.0);
+    printResult(cfg, runBench(cfg, "findSubtour_S", label + ":subtours", n, 1, [&]() {
+        vector<int> S;
+        return findSubtour_S(integral, S) ? static_cast<double>(S.size()) : 0.0;
+    }));
+
+    // point entier == tour => parcours complet sans sous tour
+    vector<vector<double>> tourPoint(n, vector<double>(n, 0.0));
+    addCycleCover(tourPoint, tour, n, 1.0);
+    printResult(cfg, runBench(cfg, "findSubtour_S", label + ":tour", n, 1, [&]() {
+        vector<int> S;
+        return findSubtour_S(tourPoint, S) ? static_cast<double>(S.size()) : 0.0;
+    }));
+
+    // point frac avec coupe violee : 1/2 tour + 1/2 couverture a 2 sous tours (blocs du tour)
+    vector<vector<double>> violated(n, vector<double>(n, 0.0));
+    addCycleCover(violated, tour, n, 0.5);
+    addCycleCover(violated, tour, max(2, n / 2), 0.5);
+    benchPoint(cfg, label + ":violated", violated);
+
+    // point frac sans coupe violee (melange de tours) => balayage complet des puits
+    vector<vector<double>> feasible(n, vector<double>(n, 0.0));
+    addCycleCover(feasible, tour, n, 0.5);
+    addCycleCover(feasible, reversed, n, 0.25);
+    addCycleCover(feasible, shuffled, n, 0.25);
+    benchPoint(cfg, label + ":feasible", feasible);
+
+    // rounds : 10 points "feasible" dont le tour melange change de 2 sommets a chaque point (~6 arcs)
+    vector<vector<vector<double>>> rounds;
+    vector<int> moving = shuffled;
+    unsigned seed = 777u;
+    for (int r = 0; r < 10 && n > 3; ++r){
+        vector<vector<double>> sol(n, vector<double>(n, 0.0));
+        addCycleCover(sol, tour, n, 0.5);
+        addCycleCover(sol, reversed, n, 0.25);
+        addCycleCover(sol, moving, n, 0.25);
+        rounds.push_back(sol);
+        seed = seed * 1103515245u + 12345u;
+        int a = 1 + static_cast<int>((seed >> 8) % (n - 1));
+        seed = seed * 1103515245u + 12345u;
+        int b = 1 + static_cast<int>((seed >> 8) % (n - 1));
+        swap(moving[a], moving[b]);
+    }
+    benchRounds(cfg, label + ":rounds", rounds);
+
+    // symetrique : x_e == x_ij + x_ji (1/2 tour dans chaque sens => x(delta(S)) >= 2)
+    if (data.symmetric){
+        vector<vector<double>> sym(n, vector<double>(n, 0.0));
+        for (int i = 0; i < n; ++i)
+            {for (int j = 0; j < n; ++j)
+                {if (i != j) sym[i][j] = feasible[i][j] + feasible[j][i];}}
+        printResult(cfg, runBench(cfg, "findSymFractionalCut_S", label + ":feasible", n, 1, [&]() {
+            vector<int> S;
+            return findSymFractionalCut_S(sym, S) ? static_cast<double>(S.size()) : 0.0;
+        }));
+        printResult(cfg, runBench(cfg, "findCombs", label + ":feasible", n, 1, [&]() {
+            vector<Comb> combs;
+            return static_cast<double>(findCombs(sym, combs));
+        }));
+    }
+}
+
+int main(int argc, char **argv){
+    BenchConfig cfg;
+    vector<string> instances;
+    vector<string> pointFiles;
+
+    for (int i = 1; i < argc; ++i){
+        string arg = argv[i];
+        if (arg == "--reps" && i + 1 < argc)
+            {cfg.reps = max(1, atoi(argv[++i]));}
+        else if (arg == "--warmup" && i + 1 < argc)
+            {cfg.warmup = max(0, atoi(argv[++i]));}
+        else if (arg == "--json")
+            {cfg.json = true;}
+        else if (arg == "--points" && i + 1 < argc)
+            {pointFiles.push_back(argv[++i]);}
+        else if (arg == "--help" || arg == "-h"){
+            cout << "usage : " << argv[0] << " [--reps N] [--warmup N] [--json] [--points FILE]... [instances...]" << endl;
+            return 0;
+        }
+        else
+            {instances.push_back(arg);}
+    }
+
+    if (instances.empty() && pointFiles.empty())
+        {instances = {"data/br17.atsp", "data/ftv33.atsp", "data/ftv70.atsp", "data/ftv170.atsp"};}
+
+    for (const string &path : instances)
+        {benchInstance(cfg, path);}
+
+    for (const string &file : pointFiles){
+        ifstream in(file);
+        if (!in){
+            cerr << "skip " << file << " (lecture impossible)" << endl;
+            continue;
+        }
+        vector<vector<vector<double>>> points = loadPoints(in);
+        string label = file.substr(file.find_last_of("/\\") + 1);
+        for (size_t k = 0; k < points.size(); ++k)
+            {benchPoint(cfg, label + ":" + to_string(k), points[k]);}
+        benchRounds(cfg, label + ":rounds", points); // points successifs de CUT_LP
+    }
+
+    return 0;
+}
@@ -0,0 +1,235 @@
+"""Time-to-target and primal-integral benchmark against known optima.
+
+Runs one mode of TSP_Gurobi over a set of instances with --summary --trace,
+rebuilds the incumbent/bound trajectory from the TRAJ lines and reports, per
+instance:
+  - time to the known optimum (incumbent == optimum)
+  - time to within X% of the optimum
+  - primal integral (Berthold's primal gap integrated over the run)
+It flags every run whose final objective or bound contradicts the optimum
+("faster but wrong" regressions) and exits with status 2 when one is found.
+
+Usage:
+    python3 scripts/benchmark_targets.py --mode CUT --gap 1 data/*.atsp
+    python3 scripts/benchmark_targets.py --mode MTZ --csv mtz.csv
+"""
+
+import argparse
+import csv
+import shlex
+import subprocess
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parents[1]
+BUILD_DIR = ROOT / "build"
+EXE = BUILD_DIR / "TSP_Gurobi"
+DATA_DIR = ROOT / "data"
+SOLUTIONS = ROOT / "data_git" / "solutions"
+
+# Published TSPLIB optima of the asymmetric instances in data/
+# (data_git/solutions only lists the symmetric ones).
+ATSP_OPTIMA = {
+    "br17": 39,
+    "ftv33": 1286,
+    "ftv35": 1473,
+    "ftv38": 1530,
+    "ftv44": 1613,
+    "ftv47": 1776,
+    "ftv55": 1608,
+    "ftv64": 1839,
+    "ftv70": 1950,
+    "ftv170": 2755,
+}
+
+# Modes whose objective is an integer tour (CUT_LP only yields a bound).
+# BOUND reports its best heuristic tour; AUTO never picks CUT_LP.
+INTEGER_MODES = {"MTZ", "MTZ_LAZY", "CUT", "CUT_INT", "CUT_HYBRID", "BOUND", "AUTO"}
+
+EPS = 1e-6
+
+
+def load_optima() -> dict:
+    optima = dict(ATSP_OPTIMA)
+    if SOLUTIONS.exists():
+        for line in SOLUTIONS.read_text(encoding="utf-8").splitlines():
+            if ":" not in line:
+                continue
+            name, value = line.split(":", 1)
+            tokens = value.split()
+            if not tokens:
+                continue
+            try:
+                optima[name.strip()] = int(tokens[0])
+            except ValueError:
+                continue
+    return optima
+
+
+def parse_fields(line: str) -> dict:
+    data = {}
+    for part in line.strip().split()[1:]:
+        if "=" not in part:
+            continue
+        key, value = part.split("=", 1)
+        data[key] = value
+    return data
+
+
+def to_float(value):
+    if value is None or value == "NA":
+        return None
+    try:
+        return float(value)
+    except ValueError:
+        return None
+
+
+def run_instance(instance_path: Path, mode: str, extra: list) -> tuple:
+    cmd = [str(EXE), str(instance_path), mode, "--summary", "--trace"] + extra
+    proc = subprocess.run(cmd, capture_output=True, text=True)
+    if proc.returncode != 0:
+        raise RuntimeError(
+            f"Command failed: {' '.join(cmd)}\nstdout:\n{proc.stdout}\nstderr:\n{proc.stderr}"
+        )
+
+    trajectory = []
+    result = None
+    for line in proc.stdout.splitlines():
+        if line.startswith("TRAJ "):
+            fields = parse_fields(line)
+            trajectory.append(
+                (to_float(fields.get("time")), to_float(fields.get("obj")), to_float(fields.get("bound")))
+            )
+        elif line.startswith("RESULT "):
+            result = parse_fields(line)
+
+    if result is None:
+        raise RuntimeError(f"No RESULT line found for {instance_path.name} ({mode}).")
+
+    # Close the trajectory with the final state reported by Gurobi.
+    end = to_float(result.get("time"))
+    if end is not None:
+        trajectory.append((end, to_float(result.get("obj")), to_float(result.get("bound"))))
+    return result, trajectory
+
+
+def primal_gap(obj, opt) -> float:
+    if obj is None:
+        return 1.0
+    if abs(obj - opt) < EPS:
+        return 0.0
+    if obj * opt < 0:
+        return 1.0
+    return abs(obj - opt) / max(abs(obj), abs(opt))
+
+
+def first_time(trajectory: list, predicate):
+    for time, obj, _ in trajectory:
+        if time is not None and obj is not None and predicate(obj):
+            return time
+    return None
+
+
+def primal_integral(trajectory: list, opt) -> float:
+    """Integral of the primal gap over [0, end], step function between points."""
+    total = 0.0
+    prev_time = 0.0
+    gap = 1.0
+    for time, obj, _ in trajectory:
+        if time is None:
+            continue
+        total += gap * max(0.0, time - prev_time)
+        prev_time = time
+        gap = primal_gap(obj, opt)
+    return total
+
+
+def check_result(mode: str, result: dict, opt) -> list:
+    """Returns the list of disagreements with the known optimum."""
+    issues = []
+    obj = to_float(result.get("obj"))
+    bound = to_float(result.get("bound"))
+    status = result.get("status", "NA")
+    tol = max(EPS, 1e-9 * abs(opt))
+    # candidate-arc model (--mem-budget): only the objective is an upper bound
+    restricted = to_float(result.get("candidate_k", "0")) not in (None, 0.0)
+
+    if bound is not None and bound > opt + tol and not restricted:
+        issues.append(f"bound {bound:g} > optimum {opt}")
+    if mode in INTEGER_MODES and obj is not None:
+        if obj < opt - tol:
+            issues.append(f"obj {obj:g} < optimum {opt}")
+        if status == "OPT" and abs(obj - opt) > tol and not restricted:
+            issues.append(f"status OPT but obj {obj:g} != optimum {opt}")
+    return issues
+
+
+def fmt(value, decimals: int = 2) -> str:
+    if value is None:
+        return "-"
+    return f"{value:.{decimals}f}"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("instances", nargs="*", type=Path, help="instances (default: data/*.atsp)")
+    parser.add_argument("--mode", default="CUT", help="solve mode passed to TSP_Gurobi (default CUT)")
+    parser.add_argument("--gap", type=float, default=1.0, help="target gap in %% for time-to-within (default 1)")
+    parser.add_argument("--csv", type=Path, help="also write the per-instance table to this CSV file")
+    parser.add_argument("--extra", default="", help="extra arguments passed to TSP_Gurobi (one quoted string)")
+    args = parser.parse_args()
+
+    if not EXE.exists():
+        print(f"Missing executable: {EXE}")
+        print("Build first: mkdir -p build && cd build && cmake .. && make TSP_Gurobi")
+        return 1
+
+    extra = shlex.split(args.extra)
+    instances = args.instances or sorted(
+        [p for p in DATA_DIR.iterdir() if p.suffix.lower() in {".tsp", ".atsp"}]
+    )
+    optima = load_optima()
+
+    header = ["instance", "mode", "opt", "obj", "bound", "status", "time",
+              "t_opt", f"t_gap{args.gap:g}", "primal_integral", "check"]
+    rows = []
+    failures = 0
+    for inst in instances:
+        name = inst.name.split(".")[0]
+        opt = optima.get(name)
+        result, trajectory = run_instance(inst, args.mode, extra)
+
+        if opt is None:
+            rows.append([inst.name, args.mode, "-", result.get("obj", "NA"), result.get("bound", "NA"),
+                         result.get("status", "NA"), result.get("time", "NA"), "-", "-", "-", "NO_OPT"])
+            continue
+
+        tol = max(EPS, 1e-9 * abs(opt))
+        t_opt = first_time(trajectory, lambda obj: abs(obj - opt) <= tol)
+        t_gap = first_time(trajectory, lambda obj: obj <= opt * (1.0 + args.gap / 100.0) + tol)
+        integral = primal_integral(trajectory, opt) if args.mode in INTEGER_MODES else None
+
+        issues = check_result(args.mode, result, opt)
+        failures += 1 if issues else 0
+        rows.append([inst.name, args.mode, str(opt), result.get("obj", "NA"), result.get("bound", "NA"),
+                     result.get("status", "NA"), result.get("time", "NA"), fmt(t_opt), fmt(t_gap),
+                     fmt(integral, 3), "WRONG: " + "; ".join(issues) if issues else "ok"])
+
+    widths = [max(len(str(r[i])) for r in rows + [header]) for i in range(len(header))]
+    for row in [header] + rows:
+        print("  ".join(str(v).ljust(w) for v, w in zip(row, widths)))
+
+    if args.csv:
+        with args.csv.open("w", newline="", encoding="utf-8") as fh:
+            writer = csv.writer(fh)
+            writer.writerow(header)
+            writer.writerows(rows)
+
+    if failures:
+        print(f"{failures} run(s) disagree with the known optimum")
+        return 2
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,132 @@
+#include "ATSP_Auto.hpp"
+#include "ATSP_Stats.hpp"
+#include <cmath>
+#include <sstream>
+
+using namespace std;
+
+InstanceFeatures instanceFeatures(const ATSPDataC &data){
+    long long start = nowNs();
+    InstanceFeatures f;
+    int n = data.size;
+    f.n = n;
+    f.symmetric = data.symmetric;
+    f.metric = data.edgeWeightType;
+    if (n <= 1)
+        {return f;}
+
+    double sum = 0.0, diff = 0.0;
+    data.visit([&](const auto &D){
+        for (int i = 0; i < n; ++i){
+            for (int j = 0; j < n; ++j){
+                if (i != j){
+                    sum += static_cast<double>(D(i, j));
+                    diff += fabs(static_cast<double>(D(i, j)) - static_cast<double>(D(j, i)));
+                }
+            }
+        }
+    });
+    f.asymmetry = (sum > 0.0) ? diff / sum : 0.0;
+
+    if (n <= InstanceFeatures::AP_MAX_N){
+        AssignmentBound ap = assignmentBound(data);
+        f.hasAP = true;
+        f.apValue = ap.value;
+        f.apCycles = ap.cycles;
+        double tol = 0.01 * sum / (static_cast<double>(n) * (n - 1));
+        long long cheap = 0;
+        for (int i = 0; i < n; ++i)
+            {for (int j = 0; j < n; ++j) cheap += (i != j && ap.reducedCost(i, j, data.dist(i, j)) <= tol);}
+        f.cheapArcs = static_cast<double>(cheap) / n;
+    }
+
+    // symetrique : 1-arborescence faible et regle "symmetric" de toute facon => pas calculee
+    if (!f.symmetric && n <= InstanceFeatures::BOUND_MAX_N){
+        f.bound = arborescenceBound(data, 100);
+        f.hasBound = true;
+        if (f.hasAP && f.bound.upper > 0)
+            {f.apGap = static_cast<double>(f.bound.upper - f.apValue) / f.bound.upper;}
+    }
+    f.ns = nowNs() - start;
+    return f;
+}
+
+// 1 regle : condition sur les caracteristiques => mode + reglages
+struct AutoRule{
+    const char *name;
+    bool (*when)(const InstanceFeatures &, const SolverParams &);
+    const char *mode;
+    void (*tune)(const InstanceFeatures &, SolverParams &);
+    const char *reason;
+};
+
+static void noTune(const InstanceFeatures &, SolverParams &) {}
+
+// table ordonnee, 1ere regle vraie retenue
+// calibrage (results.tex, ftv33..ftv170, 180 s) : MTZ gagne des n == 55 (ftv170 13 s, CUT en TL),
+// CUT a le temps moyen le plus bas sous n == 50 ; regles structurelles (AP, symetrie) hors banc
+static const AutoRule AUTO_RULES[] = {
+    {"held_karp",
+     [](const InstanceFeatures &f, const SolverParams &p) { return f.n <= p.heldKarpMax; },
+     "CUT", noTune,
+     "n <= --held-karp-max : programmation dynamique exacte"},
+    {"bound_closed",
+     [](const InstanceFeatures &f, const SolverParams &) { return f.hasBound && f.bound.optimal; },
+     "BOUND", noTune,
+     "borne 1-arborescence == meilleur tour : optimum prouve sans LP"},
+    {"ap_tour",
+     [](const InstanceFeatures &f, const SolverParams &) { return f.hasAP && f.apCycles == 1; },
+     "CUT", noTune,
+     "solution d'affectation == tour : LP racine entier, aucune coupe"},
+    {"symmetric",
+     [](const InstanceFeatures &f, const SolverParams &) { return f.symmetric; },
+     "CUT", noTune,
+     "symetrique : modele aretes n(n-1)/2 + peignes (STSP_CUT)"},
+    {"tight_ap",
+     [](const InstanceFeatures &f, const SolverParams &) { return f.apGap >= 0.0 && f.apGap <= 0.01; },
+     "CUT", noTune,
+     "gap AP <= 1% : peu de coupes sous tour, relaxation MTZ trop faible"},
+    {"degenerate_ap",
+     [](const InstanceFeatures &f, const SolverParams &) { return f.cheapArcs >= 4.0; },
+     "CUT", [](const InstanceFeatures &, SolverParams &p) { p.seedTwoCycles = true; },
+     ">= 4 arcs de cout reduit AP ~0 par sommet : 2-cycles frequents, poses d'avance (Lazy)"},
+    {"large_asym",
+     [](const InstanceFeatures &f, const SolverParams &) { return f.n >= 50; },
+     "MTZ", [](const InstanceFeatures &f, SolverParams &p) { p.arcElim = p.arcElim || (f.hasBound && f.n >= 100); },
+     "asymetrique, n >= 50 : MTZ plus rapide que CUT (ftv55..ftv170) ; n >= 100 : arcs elimines par couts reduits"},
+    {"small_asym",
+     [](const InstanceFeatures &, const SolverParams &) { return true; },
+     "CUT", noTune,
+     "asymetrique, n < 50 : CUT plus rapide en moyenne (ftv33..ftv47)"},
+};
+
+AutoChoice chooseMode(const InstanceFeatures &f, const SolverParams &params){
+    AutoChoice c;
+    c.params = params;
+    for (const AutoRule &r : AUTO_RULES){
+        if (!r.when(f, params))
+            {continue;}
+        c.mode = r.mode;
+        c.rule = r.name;
+        c.reason = r.reason;
+        r.tune(f, c.params);
+        break;
+    }
+    return c;
+}
+
+string describeChoice(const InstanceFeatures &f, const AutoChoice &c){
+    ostringstream out;
+    out << "AUTO n=" << f.n << " metric=" << f.metric << " sym=" << f.symmetric << " asym=" << f.asymmetry;
+    if (f.hasAP)
+        {out << " ap=" << f.apValue << " ap_cycles=" << f.apCycles << " cheap_arcs=" << f.cheapArcs;}
+    if (f.hasBound)
+        {out << " lagr_bound=" << f.bound.bound << " upper=" << f.bound.upper << " ap_gap=" << f.apGap;}
+    out << " (" << nsToSec(f.ns) << " s) => " << c.mode;
+    if (c.params.seedTwoCycles)
+        {out << " --seed-2cycles";}
+    if (c.params.arcElim)
+        {out << " --arc-elim";}
+    out << " [" << c.rule << "] " << c.reason;
+    return out.str();
+}
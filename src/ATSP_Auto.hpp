@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include "ATSP_Data.hpp"
+#include "ATSP_Bound.hpp"
+#include "ATSP_Params.hpp"
+
+using namespace std;
+
+// ======================================================================
+// ============== MODE AUTO (choix de formulation par regles) ===========
+// ======================================================================
+// caracteristiques peu cheres de l'instance => 1ere regle satisfaite de la table (ATSP_Auto.cpp)
+
+struct InstanceFeatures{
+    int n = 0;
+    bool symmetric = false;
+    string metric;          // EDGE_WEIGHT_TYPE (EXPLICIT, EUC_2D, GEO ...)
+    double asymmetry = 0.0; // sum |c_ij - c_ji| / sum c_ij (0 == symetrique)
+
+    bool hasAP = false;     // n <= AP_MAX_N
+    long long apValue = 0;  // relaxation d'affectation
+    int apCycles = 0;       // nb de cycles de la couverture (1 == tour optimal)
+    double cheapArcs = 0.0; // arcs de cout reduit AP <= 1% du cout moyen, par sommet (degenerescence)
+
+    bool hasBound = false;  // asymetrique et n <= BOUND_MAX_N
+    LagrangianBound bound;  // 1-arborescence (upper == meilleur tour heuristique)
+    double apGap = -1.0;    // (upper - AP) / upper ; < 0 si inconnu
+
+    long long ns = 0;       // temps de calcul des caracteristiques
+
+    static const int AP_MAX_N = 2000;   // hongroise O(n^3)
+    static const int BOUND_MAX_N = 1000; // sous gradient dense, ~28 n^2 octets
+};
+
+InstanceFeatures instanceFeatures(const ATSPDataC &data);
+
+struct AutoChoice{
+    string mode;         // MTZ | MTZ_LAZY | CUT | CUT_LP | BOUND
+    SolverParams params; // params de l'appelant + reglages de la regle
+    string rule;         // nom de la regle retenue
+    string reason;       // pourquoi (journal)
+};
+
+// params == valeurs de la ligne de commande (threads, temps limite ...) ; la regle n'ajoute que ses reglages
+AutoChoice chooseMode(const InstanceFeatures &f, const SolverParams &params);
+
+// 1 ligne "AUTO ..." : caracteristiques + choix + raison
+string describeChoice(const InstanceFeatures &f, const AutoChoice &c);
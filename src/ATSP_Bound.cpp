@@ -0,0 +1,619 @@
+#include "ATSP_Bound.hpp"
+#include "ATSP_Stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+static const double ARB_INF = numeric_limits<double>::infinity();
+
+// 1 niveau de contraction d'Edmonds
+struct ArbLevel{
+    int size;              // nb de sommets du niveau
+    int root;
+    vector<double> y;      // dual (== cout reduit min entrant) de chaque sommet
+    vector<int> inArc;     // arc d'origine (u * n + v) realisant y
+    vector<int> comp;      // sommet du niveau suivant
+    vector<char> inCycle;
+};
+
+double minArborescence(int n, int root, const vector<double> &c, vector<int> &parent, vector<double> *rc){
+    parent.assign(n, -1);
+    if (n <= 1){
+        if (rc)
+            {rc->assign(static_cast<size_t>(n) * n, 0.0);}
+        return 0.0;
+    }
+
+    // niveau courant : couts reduits C[a * N + b], arc d'origine orig[a * N + b]
+    int N = n, r = root;
+    vector<double> C(c);
+    vector<int> orig(static_cast<size_t>(n) * n);
+    for (int i = 0; i < n; ++i){
+        for (int j = 0; j < n; ++j){
+            orig[static_cast<size_t>(i) * n + j] = i * n + j;
+            if (i == j || j == root)
+                {C[static_cast<size_t>(i) * n + j] = ARB_INF;}
+        }
+    }
+
+    vector<ArbLevel> levels;
+    vector<vector<int>> ids(1, vector<int>(n)); // ids[l][v] == sommet du niveau l contenant v
+    for (int v = 0; v < n; ++v)
+        {ids[0][v] = v;}
+    double total = 0.0;
+
+    while (true){
+        ArbLevel L;
+        L.size = N;
+        L.root = r;
+        L.y.assign(N, 0.0);
+        L.inArc.assign(N, -1);
+        vector<int> inU(N, -1);
+
+        // arc entrant min de chaque sommet
+        for (int v = 0; v < N; ++v){
+            if (v == r)
+                {continue;}
+            double best = ARB_INF;
+            for (int u = 0; u < N; ++u){
+                if (C[static_cast<size_t>(u) * N + v] < best){
+                    best = C[static_cast<size_t>(u) * N + v];
+                    inU[v] = u;
+                }
+            }
+            if (inU[v] < 0)
+                {return ARB_INF;} // v inaccessible depuis root
+            L.y[v] = best;
+            L.inArc[v] = orig[static_cast<size_t>(inU[v]) * N + v];
+            total += best;
+        }
+
+        // cycles des arcs entrants min
+        L.comp.assign(N, -1);
+        L.inCycle.assign(N, 0);
+        vector<int> mark(N, -1);
+        int next = 0;
+        for (int s = 0; s < N; ++s){
+            int v = s;
+            while (v != r && mark[v] < 0){
+                mark[v] = s;
+                v = inU[v];
+            }
+            if (v != r && mark[v] == s && L.comp[v] < 0){
+                // cycle passant par v
+                int w = v;
+                do{
+                    L.comp[w] = next;
+                    L.inCycle[w] = 1;
+                    w = inU[w];
+                } while (w != v);
+                next++;
+            }
+        }
+        bool hasCycle = (next > 0);
+        for (int v = 0; v < N; ++v)
+            {if (L.comp[v] < 0) L.comp[v] = next++;}
+
+        levels.push_back(L);
+        if (!hasCycle)
+            {break;}
+
+        // contraction : C'[a][b] == min (C[u][v] - y[v]), u dans a, v dans b, a != b
+        int N2 = next;
+        vector<double> C2(static_cast<size_t>(N2) * N2, ARB_INF);
+        vector<int> orig2(static_cast<size_t>(N2) * N2, -1);
+        const ArbLevel &cur = levels.back();
+        for (int u = 0; u < N; ++u){
+            int a = cur.comp[u];
+            for (int v = 0; v < N; ++v){
+                int b = cur.comp[v];
+                double w = C[static_cast<size_t>(u) * N + v];
+                if (a == b || v == r || w == ARB_INF)
+                    {continue;}
+                w -= cur.y[v];
+                size_t cell = static_cast<size_t>(a) * N2 + b;
+                if (w < C2[cell]){
+                    C2[cell] = w;
+                    orig2[cell] = orig[static_cast<size_t>(u) * N + v];
+                }
+            }
+        }
+
+        vector<int> nextIds(n);
+        for (int v = 0; v < n; ++v)
+            {nextIds[v] = cur.comp[ids.back()[v]];}
+        ids.push_back(nextIds);
+        r = cur.comp[r];
+        N = N2;
+        C.swap(C2);
+        orig.swap(orig2);
+    }
+
+    // expansion : sommet de cycle == arc choisi au niveau superieur s'il y entre, sinon son arc du cycle
+    int top = static_cast<int>(levels.size()) - 1;
+    vector<int> chosen(levels[top].inArc);
+    for (int l = top - 1; l >= 0; --l){
+        const ArbLevel &L = levels[l];
+        vector<int> below(L.size, -1);
+        for (int w = 0; w < L.size; ++w){
+            if (w == L.root)
+                {continue;}
+            int arc = chosen[L.comp[w]];
+            if (!L.inCycle[w] || ids[l][arc % n] == w)
+                {below[w] = arc;}
+            else
+                {below[w] = L.inArc[w];}
+        }
+        chosen.swap(below);
+    }
+    for (int v = 0; v < n; ++v)
+        {if (v != root) parent[v] = chosen[v] / n;}
+
+    // couts reduits : on retire y du sommet contenant j a chaque niveau ou i et j sont separes
+    if (rc){
+        rc->assign(static_cast<size_t>(n) * n, 0.0);
+        for (int i = 0; i < n; ++i){
+            for (int j = 0; j < n; ++j){
+                if (i == j || j == root)
+                    {continue;}
+                double v = c[static_cast<size_t>(i) * n + j];
+                for (size_t l = 0; l < levels.size() && ids[l][i] != ids[l][j]; ++l)
+                    {v -= levels[l].y[ids[l][j]];}
+                (*rc)[static_cast<size_t>(i) * n + j] = max(0.0, v);
+            }
+        }
+    }
+    return total;
+}
+
+// meilleur tour plus proche voisin (selon key(i, j)) sur quelques departs ; renvoie son cout reel
+template <typename Key>
+static long long nearestNeighborUpper(const ATSPDataC &data, Key key, vector<int> &tour){
+    int n = data.size;
+    long long best = -1;
+    vector<char> used(n);
+    vector<int> cur;
+    for (int s = 0; s < min(n, 10); ++s){
+        fill(used.begin(), used.end(), 0);
+        cur.assign(1, s);
+        used[s] = 1;
+        long long len = 0;
+        for (int step = 1; step < n; ++step){
+            int from = cur.back(), nxt = -1;
+            for (int j = 0; j < n; ++j)
+                {if (!used[j] && (nxt < 0 || key(from, j) < key(from, nxt))) nxt = j;}
+            used[nxt] = 1;
+            len += data.dist(from, nxt);
+            cur.push_back(nxt);
+        }
+        len += data.dist(cur.back(), s);
+        if (best < 0 || len < best){
+            best = len;
+            tour = cur;
+        }
+    }
+    return best;
+}
+
+// ---------------- recherche locale (ATSP : mouvements sans inversion de segment) ----------------
+
+// K meilleurs successeurs / predecesseurs de chaque sommet selon key(i, j)
+struct TourNeighbors{
+    int k = 0;
+    vector<int> out; // out[i * k + r] : r-ieme successeur de i
+    vector<int> in;  // in[j * k + r]  : r-ieme predecesseur de j
+};
+
+template <typename Key>
+static TourNeighbors tourNeighbors(int n, int K, Key key){
+    TourNeighbors nb;
+    nb.k = min(K, n - 1);
+    nb.out.resize(static_cast<size_t>(n) * nb.k);
+    nb.in.resize(static_cast<size_t>(n) * nb.k);
+    vector<int> cand(n - 1);
+    for (int v = 0; v < n; ++v){
+        int m = 0;
+        for (int w = 0; w < n; ++w)
+            {if (w != v) cand[m++] = w;}
+        partial_sort(cand.begin(), cand.begin() + nb.k, cand.end(), [&](int a, int b){ return key(v, a) < key(v, b); });
+        copy(cand.begin(), cand.begin() + nb.k, nb.out.begin() + static_cast<size_t>(v) * nb.k);
+        partial_sort(cand.begin(), cand.begin() + nb.k, cand.end(), [&](int a, int b){ return key(a, v) < key(b, v); });
+        copy(cand.begin(), cand.begin() + nb.k, nb.in.begin() + static_cast<size_t>(v) * nb.k);
+    }
+    return nb;
+}
+
+// tour (ordre de visite) + position de chaque sommet ; next == buffer de reconstruction
+struct TourState{
+    vector<int> tour, pos, next;
+
+    int n() const { return static_cast<int>(tour.size()); }
+    int at(int t) const { return tour[t % n()]; }
+    void index(){
+        pos.resize(tour.size());
+        for (int t = 0; t < n(); ++t)
+            {pos[tour[t]] = t;}
+    }
+    // echange des segments (i, i+j] et (i+j, i+k] (0 < j < k < n, indices modulo n) :
+    // t_i t_{i+j+1}..t_{i+k} t_{i+1}..t_{i+j} t_{i+k+1}.. == 3-opt sans inversion (tour repris depuis t_i)
+    void swapSegments(int i, int j, int k){
+        int m = n();
+        next.clear();
+        next.push_back(at(i));
+        for (int t = j + 1; t <= k; ++t)
+            {next.push_back(at(i + t));}
+        for (int t = 1; t <= j; ++t)
+            {next.push_back(at(i + t));}
+        for (int t = k + 1; t < m; ++t)
+            {next.push_back(at(i + t));}
+        tour.swap(next);
+        index();
+    }
+};
+
+// 1 mouvement ameliorant (premier trouve) retirant l'arc sortant de a : segment de 1 a 3 sommets deplace
+// (or-opt) ou 2 segments consecutifs echanges (3-opt sans inversion), arcs ajoutes pris dans les listes
+// de voisins ; touched == extremites des arcs modifies
+static long long improveAt(const ATSPDataC &data, const TourNeighbors &nb, TourState &st, int a, vector<int> &touched){
+    int n = st.n(), K = nb.k, i = st.pos[a];
+    int a1 = st.at(i + 1);
+    long long dA = data.dist(a, a1);
+
+    // 3-opt : nouveaux arcs (a, t_{j+1}), (t_k, a1), (t_j, t_{k+1}) ; 0 < j < k < n relatifs a i
+    for (int r = 0; r < K; ++r){
+        int v = nb.out[static_cast<size_t>(a) * K + r]; // t_{j+1}
+        int j = (st.pos[v] - i + n) % n - 1;
+        if (j < 1)
+            {continue;}
+        int tj = st.at(i + j);
+        long long g1 = dA + data.dist(tj, v) - data.dist(a, v);
+        if (g1 <= 0)
+            {continue;}
+        for (int q = 0; q < K; ++q){
+            int c = nb.in[static_cast<size_t>(a1) * K + q]; // t_k
+            int k = (st.pos[c] - i + n) % n;
+            if (k <= j)
+                {continue;}
+            int c1 = st.at(i + k + 1);
+            long long gain = g1 + data.dist(c, c1) - data.dist(c, a1) - data.dist(tj, c1);
+            if (gain > 0){
+                touched = {a, a1, tj, v, c, c1};
+                st.swapSegments(i, j, k);
+                return gain;
+            }
+        }
+    }
+
+    // or-opt : segment a1..t_{i+L} (L <= 3) reinsere entre b et b1, b parmi les predecesseurs proches de a1
+    for (int L = 1; L <= 3 && L < n - 2; ++L){
+        int sL = st.at(i + L), q = st.at(i + L + 1);
+        long long g1 = dA + data.dist(sL, q) - data.dist(a, q);
+        if (g1 <= 0)
+            {continue;}
+        for (int r = 0; r < K; ++r){
+            int b = nb.in[static_cast<size_t>(a1) * K + r];
+            int k = (st.pos[b] - i + n) % n; // b apres le segment : L < k < n
+            if (k <= L)
+                {continue;}
+            int b1 = st.at(i + k + 1);
+            long long gain = g1 + data.dist(b, b1) - data.dist(b, a1) - data.dist(sL, b1);
+            if (gain > 0){
+                touched = {a, a1, sL, q, b, b1};
+                st.swapSegments(i, L, k); // == segment (i, i+L] apres b
+                return gain;
+            }
+        }
+    }
+    return 0;
+}
+
+// descente jusqu'a l'optimum local depuis les sommets de work (don't-look bits : seuls les sommets
+// voisins d'un arc modifie sont re-examines)
+static long long localSearch(const ATSPDataC &data, const TourNeighbors &nb, TourState &st, long long len,
+                             vector<int> &work){
+    int n = st.n();
+    if (n < 5)
+        {return len;}
+    vector<char> queued(n, 0);
+    for (int v : work)
+        {queued[v] = 1;}
+    vector<int> touched;
+    for (size_t h = 0; h < work.size(); ++h){
+        int a = work[h];
+        queued[a] = 0;
+        long long gain = improveAt(data, nb, st, a, touched);
+        if (gain <= 0)
+            {continue;}
+        len -= gain;
+        touched.push_back(a);
+        for (int v : touched){
+            for (int w : {v, st.at(st.pos[v] + n - 1)}){ // v et son predecesseur
+                if (!queued[w]){
+                    queued[w] = 1;
+                    work.push_back(w);
+                }
+            }
+        }
+    }
+    work.clear();
+    return len;
+}
+
+// recherche locale iteree : perturbation == 3-opt aleatoire (double pont sans inversion),
+// descente, garde si meilleur ; tour / len == meilleur trouve
+static long long iteratedLocalSearch(const ATSPDataC &data, const TourNeighbors &nb, vector<int> &tour, long long len,
+                                     int kicks, unsigned seed){
+    int n = static_cast<int>(tour.size());
+    TourState st;
+    st.tour = tour;
+    st.index();
+    vector<int> work(tour);
+    len = localSearch(data, nb, st, len, work);
+    tour = st.tour;
+    if (n < 8)
+        {return len;}
+    int maxSeg = max(1, min(50, (n - 1) / 3));
+    for (int it = 0; it < kicks; ++it){
+        int r[3];
+        for (int &v : r){
+            seed = seed * 1103515245u + 12345u;
+            v = static_cast<int>(seed >> 8);
+        }
+        int i = r[0] % n, j = 1 + r[1] % maxSeg, k = j + 1 + r[2] % maxSeg; // 2 segments courts consecutifs
+        int ti = st.at(i), ti1 = st.at(i + 1), tj = st.at(i + j), tj1 = st.at(i + j + 1);
+        int tk = st.at(i + k), tk1 = st.at(i + k + 1);
+        long long cur = len - data.dist(ti, ti1) - data.dist(tj, tj1) - data.dist(tk, tk1)
+                      + data.dist(ti, tj1) + data.dist(tk, ti1) + data.dist(tj, tk1);
+        st.swapSegments(i, j, k);
+        work = {ti, ti1, tj, tj1, tk, tk1};
+        cur = localSearch(data, nb, st, cur, work);
+        if (cur < len){
+            len = cur;
+            tour = st.tour;
+        }
+        else{
+            st.tour = tour;
+            st.index();
+        }
+    }
+    return len;
+}
+
+// couts reduits aux penalites pi (cp == couts penalises, recalcules) ; arcs entrants dans 0 relatifs au moins cher
+static void reducedCosts(const ATSPDataC &data, const vector<double> &pi, vector<double> &cp, vector<int> &parent,
+                         vector<double> &rc){
+    int n = data.size;
+    for (int i = 0; i < n; ++i)
+        {for (int j = 0; j < n; ++j) cp[static_cast<size_t>(i) * n + j] = (i == j) ? 0.0 : data.dist(i, j) + pi[i];}
+    minArborescence(n, 0, cp, parent, &rc);
+    double in0 = ARB_INF;
+    for (int i = 1; i < n; ++i)
+        {in0 = min(in0, cp[static_cast<size_t>(i) * n]);}
+    for (int i = 0; i < n; ++i)
+        {rc[static_cast<size_t>(i) * n] = (i == 0) ? 0.0 : cp[static_cast<size_t>(i) * n] - in0;}
+}
+
+// tours de reparation : plus proche voisin sur les couts reduits (arcs "presque" dans la 1-arborescence
+// d'abord) et meilleur tour courant, chacun ameliore par recherche locale iteree sur les voisins par cout
+// reduit ; lb garde le meilleur
+static void repairTour(const ATSPDataC &data, const vector<double> &rc, int kicks, LagrangianBound &lb){
+    int n = data.size;
+    auto key = [&](int i, int j){ return rc[static_cast<size_t>(i) * n + j] + 1e-9 * data.dist(i, j); };
+    TourNeighbors nb = tourNeighbors(n, 8, key);
+    vector<int> tour;
+    long long len = nearestNeighborUpper(data, key, tour);
+    len = iteratedLocalSearch(data, nb, tour, len, kicks, 2024u + lb.iterations);
+    if (len < lb.upper){
+        lb.upper = len;
+        lb.tour.swap(tour);
+    }
+    tour = lb.tour;
+    len = iteratedLocalSearch(data, nb, tour, lb.upper, kicks, 7u + lb.iterations);
+    if (len < lb.upper){
+        lb.upper = len;
+        lb.tour.swap(tour);
+    }
+}
+
+LagrangianBound arborescenceBound(const ATSPDataC &data, int maxIter){
+    long long start = nowNs();
+    LagrangianBound lb;
+    int n = data.size;
+    lb.bound = -ARB_INF;
+    if (n <= 0)
+        {return lb;}
+    // upper de depart (pas de Polyak) : plus proche voisin + recherche locale iteree sur les plus proches voisins
+    lb.upper = nearestNeighborUpper(data, [&](int i, int j){ return data.dist(i, j); }, lb.tour);
+    int kicks = 10 * n;
+    if (n > 2){
+        TourNeighbors nb = tourNeighbors(n, 8, [&](int i, int j){ return data.dist(i, j); });
+        lb.upper = iteratedLocalSearch(data, nb, lb.tour, lb.upper, kicks, 1u);
+    }
+    if (n <= 2){
+        lb.bound = static_cast<double>(lb.upper);
+        lb.pi.assign(n, 0.0);
+        lb.rc.assign(static_cast<size_t>(n) * n, 0.0);
+        lb.optimal = true;
+        lb.ns = nowNs() - start;
+        return lb;
+    }
+
+    vector<double> pi(n, 0.0), cp(static_cast<size_t>(n) * n), rc;
+    lb.pi = pi;
+    vector<int> parent, outDeg(n);
+    double lambda = 2.0;
+    int stall = 0;
+    int nextRepair = 25; // tours de reparation aux iterations 25, 50, 100, ... (penalites de la meilleure borne)
+
+    for (int it = 0; it < maxIter && lambda > 2e-2; ++it){
+        lb.iterations = it + 1;
+        if (lb.iterations == nextRepair){
+            reducedCosts(data, lb.pi, cp, parent, rc);
+            repairTour(data, rc, kicks / 4, lb);
+            nextRepair *= 2;
+        }
+
+        double sumPi = 0.0;
+        for (int i = 0; i < n; ++i){
+            sumPi += pi[i];
+            for (int j = 0; j < n; ++j)
+                {cp[static_cast<size_t>(i) * n + j] = (i == j) ? 0.0 : data.dist(i, j) + pi[i];}
+        }
+
+        double arb = minArborescence(n, 0, cp, parent);
+        int back = 1; // arc entrant dans 0 le moins cher
+        for (int i = 2; i < n; ++i)
+            {if (cp[static_cast<size_t>(i) * n] < cp[static_cast<size_t>(back) * n]) back = i;}
+        double in0 = cp[static_cast<size_t>(back) * n];
+        double value = arb + in0 - sumPi;
+
+        fill(outDeg.begin(), outDeg.end(), 0);
+        for (int v = 1; v < n; ++v)
+            {outDeg[parent[v]]++;}
+        outDeg[back]++;
+        double norm = 0.0;
+        for (int i = 0; i < n; ++i)
+            {norm += static_cast<double>(outDeg[i] - 1) * (outDeg[i] - 1);}
+
+        if (value > lb.bound + 1e-9){
+            lb.bound = value;
+            lb.pi = pi;
+            stall = 0;
+        }
+        else if (++stall >= 10){
+            lambda /= 2.0;
+            stall = 0;
+        }
+
+        // degres sortants tous == 1 : la 1-arborescence est un tour (optimal pour ces penalites)
+        if (norm == 0.0){
+            long long len = 0;
+            for (int v = 1; v < n; ++v)
+                {len += data.dist(parent[v], v);}
+            len += data.dist(back, 0);
+            if (len < lb.upper){
+                lb.upper = len;
+                lb.tour.assign(1, 0);
+                for (int v = 0; lb.tour.size() < static_cast<size_t>(n);){
+                    int nxt = -1;
+                    for (int w = 1; w < n && nxt < 0; ++w)
+                        {if (parent[w] == v) nxt = w;}
+                    lb.tour.push_back(nxt);
+                    v = nxt;
+                }
+            }
+            break;
+        }
+        if (ceil(lb.bound - 1e-6) >= lb.upper)
+            {break;}
+
+        double step = lambda * (static_cast<double>(lb.upper) - value) / norm;
+        for (int i = 0; i < n; ++i)
+            {pi[i] += step * (outDeg[i] - 1);}
+    }
+
+    // couts reduits aux meilleures penalites + dernier tour de reparation (meilleur tour garde)
+    reducedCosts(data, lb.pi, cp, parent, lb.rc);
+    if (ceil(lb.bound - 1e-6) < lb.upper)
+        {repairTour(data, lb.rc, kicks, lb);}
+    rotate(lb.tour.begin(), find(lb.tour.begin(), lb.tour.end(), 0), lb.tour.end()); // depuis 0
+
+    lb.optimal = ceil(lb.bound - 1e-6) >= lb.upper;
+    lb.ns = nowNs() - start;
+    return lb;
+}
+
+vector<vector<char>> reducedCostArcs(const LagrangianBound &lb, int n, long long &removed){
+    vector<vector<char>> keep(n, vector<char>(n, 0));
+    removed = 0;
+    for (int i = 0; i < n; ++i){
+        for (int j = 0; j < n; ++j){
+            if (i == j)
+                {continue;}
+            keep[i][j] = (lb.bound + lb.rc[static_cast<size_t>(i) * n + j] <= lb.upper + 1e-6);
+        }
+    }
+    // arcs du tour de reference toujours gardes (bound + rc <= upper a l'arrondi pres)
+    for (size_t k = 0; k < lb.tour.size(); ++k)
+        {keep[lb.tour[k]][lb.tour[(k + 1) % lb.tour.size()]] = 1;}
+    for (int i = 0; i < n; ++i)
+        {for (int j = 0; j < n; ++j) removed += (i != j && !keep[i][j]);}
+    return keep;
+}
+
+AssignmentBound assignmentBound(const ATSPDataC &data){
+    AssignmentBound ap;
+    int n = data.size;
+    if (n <= 1)
+        {return ap;}
+
+    // diagonale interdite : cout > tout tour
+    long long big = 1;
+    for (int i = 0; i < n; ++i)
+        {for (int j = 0; j < n; ++j) if (i != j) big = max(big, data.dist(i, j) + 1);}
+    big *= n;
+    auto cost = [&](int i, int j) { return i == j ? big : data.dist(i, j); };
+
+    // indices 1..n, colonne 0 fictive ; rowOf[j] == ligne affectee a j
+    const long long INF = numeric_limits<long long>::max() / 4;
+    vector<long long> u(n + 1, 0), v(n + 1, 0), minv(n + 1);
+    vector<int> rowOf(n + 1, 0), way(n + 1, 0);
+    vector<char> used(n + 1);
+    for (int i = 1; i <= n; ++i){
+        rowOf[0] = i;
+        int j0 = 0;
+        fill(minv.begin(), minv.end(), INF);
+        fill(used.begin(), used.end(), 0);
+        do{
+            used[j0] = 1;
+            int i0 = rowOf[j0], j1 = 0;
+            long long delta = INF;
+            for (int j = 1; j <= n; ++j){
+                if (used[j])
+                    {continue;}
+                long long cur = cost(i0 - 1, j - 1) - u[i0] - v[j];
+                if (cur < minv[j]){
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta){
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= n; ++j){
+                if (used[j]){
+                    u[rowOf[j]] += delta;
+                    v[j] -= delta;
+                }
+                else
+                    {minv[j] -= delta;}
+            }
+            j0 = j1;
+        } while (rowOf[j0] != 0);
+        do{ // augmentation le long du chemin
+            int j1 = way[j0];
+            rowOf[j0] = rowOf[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    ap.succ.assign(n, -1);
+    ap.u.assign(u.begin() + 1, u.end());
+    ap.v.assign(v.begin() + 1, v.end());
+    for (int j = 1; j <= n; ++j){
+        ap.succ[rowOf[j] - 1] = j - 1;
+        ap.value += cost(rowOf[j] - 1, j - 1);
+    }
+    vector<char> seen(n, 0);
+    for (int s = 0; s < n; ++s){
+        if (seen[s])
+            {continue;}
+        ap.cycles++;
+        for (int w = s; !seen[w]; w = ap.succ[w])
+            {seen[w] = 1;}
+    }
+    return ap;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include "ATSP_Data.hpp"
+
+using namespace std;
+
+// ======================================================================
+// ============== BORNE LAGRANGIENNE (1-arborescence, sans LP) ==========
+// ======================================================================
+// 1-arborescence == arborescence couvrante enracinee en 0 + arc entrant dans 0 le moins cher
+// tout tour en est une => cout min == borne inf ; degres sortants == 1 relaches (penalites pi_i)
+//   c'_ij = c_ij + pi_i,  L(pi) = 1-arb(c') - sum pi_i,  pi maximise par sous gradient (g_i = d+(i) - 1)
+
+// arborescence couvrante de cout min enracinee en root (Chu-Liu / Edmonds sur matrice dense, O(n^2) par niveau)
+// c[i * n + j] == cout de i -> j (arcs vers root ignores) ; parent[root] == -1
+// rc != nullptr => couts reduits des duaux laminaires d'Edmonds : rc >= 0, == 0 sur l'arborescence
+//   (arborescence forcee a contenir i -> j : cout >= optimum + rc[i * n + j])
+double minArborescence(int n, int root, const vector<double> &c, vector<int> &parent, vector<double> *rc = nullptr);
+
+struct LagrangianBound{
+    double bound = 0.0;   // max L(pi) (borne inf du tour optimal ; couts entiers => arrondir au dessus)
+    long long upper = -1; // meilleur tour connu (plus proche voisin + or-opt / 3-opt itere, sur couts puis couts reduits)
+    vector<int> tour;     // tour de cout upper (depuis 0)
+    vector<double> pi;    // penalites de la meilleure borne
+    vector<double> rc;    // rc[i * n + j] : tout tour contenant i -> j coute >= bound + rc
+    int iterations = 0;
+    bool optimal = false; // bound == upper (a l'arrondi pres)
+    long long ns = 0;     // temps total
+
+    bool empty() const { return pi.empty(); }
+};
+
+// sous gradient (pas de Polyak vers upper, divise par 2 apres 10 iterations sans progres) ; tours de
+// reparation sur couts reduits aux iterations 25, 50, 100, ... et a la fin, le meilleur est garde
+LagrangianBound arborescenceBound(const ATSPDataC &data, int maxIter = 500);
+
+// arcs gardes : bound + rc_ij <= upper (les autres ne sont dans aucun tour de cout <= upper)
+// removed == nb d'arcs elimines
+vector<vector<char>> reducedCostArcs(const LagrangianBound &lb, int n, long long &removed);
+
+// ======================================================================
+// ============== RELAXATION D'AFFECTATION (AP) =========================
+// ======================================================================
+// min sum c_ij x_ij, degres == 1, sans contrainte de sous tour : couverture par cycles de cout min
+// duaux u_i + v_j <= c_ij (== sur les arcs choisis) => cout reduit c_ij - u_i - v_j >= 0
+
+struct AssignmentBound{
+    long long value = 0;    // cout de la couverture (borne inf du tour optimal)
+    vector<int> succ;       // succ[i] == j si x_ij == 1
+    vector<long long> u, v; // duaux lignes / colonnes
+    int cycles = 0;         // nb de cycles de la couverture (1 == tour optimal)
+
+    long long reducedCost(int i, int j, long long cij) const { return cij - u[i] - v[j]; }
+};
+
+// methode hongroise (chemins augmentants + potentiels), O(n^3)
+AssignmentBound assignmentBound(const ATSPDataC &data);
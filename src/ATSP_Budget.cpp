@@ -0,0 +1,150 @@
+#include "ATSP_Budget.hpp"
+#include "ATSP_Neighbors.hpp"
+#include <algorithm>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+// octets par element (approx.) : colonne, ligne, non nul (matrice stockee en lignes et colonnes)
+static const double BYTES_PER_VAR = 120.0;
+static const double BYTES_PER_ROW = 100.0;
+static const double BYTES_PER_NNZ = 40.0;
+
+ModelSize estimateModelSize(int n, const string &mode, bool symmetricModel, int threads, int candidateK){
+    long long N = n;
+    long long arcs = N * (N - 1);
+    if (candidateK > 0 && !symmetricModel)
+        {arcs = min(arcs, N * (2LL * candidateK + 1));}
+
+    ModelSize size{0, 0, 0, 0.0};
+    double client = 4.0 * N * N; // distances (int32 ; uint16 => 2x moins, inconnu avant lecture)
+
+    if (mode == "BOUND"){
+        // pas de modele : couts penalises, couts reduits (double) + arcs d'origine (int) de minArborescence
+        size.vars = size.rows = size.nnz = 0;
+        client += 28.0 * N * N;
+    }
+    else if (mode == "MTZ" || mode == "MTZ_LAZY"){
+        size.vars = arcs + N;
+        size.rows = 2 * N + 1;
+        size.nnz = 2 * arcs + 1;
+        if (mode == "MTZ"){
+            size.rows += (N - 1) * (N - 2);
+            size.nnz += 3 * (N - 1) * (N - 2);
+        }
+        client += 16.0 * N * N; // x[i][j]
+    }
+    else if (symmetricModel){
+        size.vars = arcs / 2;
+        size.rows = N;
+        size.nnz = arcs;
+        client += 16.0 * N * N + 8.0 * N * N; // x[i][j] + point du callback
+    }
+    else{
+        size.vars = arcs + N;
+        size.rows = 2 * N;
+        size.nnz = 2 * arcs;
+        // x[i][j] + par thread : point + graphe push-relabel CSR (24 o / arc au pire : support complet)
+        client += 16.0 * N * N + max(1, threads) * (8.0 * N * N + 24.0 * arcs);
+        // CUT_LP / racine de CUT_HYBRID : flots repris d'un round a l'autre, 1 double par arc du support et par puits
+        // (support d'un sommet LP : ~ lignes == 2n + coupes => ~8 arcs CSR par sommet)
+        if (mode == "CUT_LP" || mode == "CUT_HYBRID")
+            {client += 8.0 * N * (8.0 * N);}
+    }
+
+    double gurobi = BYTES_PER_VAR * size.vars + BYTES_PER_ROW * size.rows + BYTES_PER_NNZ * size.nnz;
+    size.memMB = (gurobi + client) / (1024.0 * 1024.0);
+    return size;
+}
+
+// entrants dans i : k plus proches par colonne (sortants : nearestNeighborGraph)
+template <typename Matrix>
+static void addNearestIn(const Matrix &D, int n, int k, vector<vector<char>> &cand){
+    int kk = min(k, n - 1);
+    vector<int> order;
+    for (int i = 0; i < n; ++i){
+        order.clear();
+        for (int j = 0; j < n; ++j)
+            {if (j != i) order.push_back(j);}
+        partial_sort(order.begin(), order.begin() + kk, order.end(),
+                     [&](int a, int b) { return D(a, i) < D(b, i); });
+        for (int t = 0; t < kk; ++t)
+            {cand[order[t]][i] = 1;}
+    }
+}
+
+// tour plus proche voisin depuis 0
+template <typename Matrix>
+static void addNearestNeighborTour(const Matrix &D, int n, vector<vector<char>> &cand){
+    vector<bool> used(n, false);
+    int cur = 0;
+    used[0] = true;
+    for (int step = 1; step < n; ++step){
+        int best = -1;
+        for (int j = 0; j < n; ++j){
+            if (!used[j] && (best < 0 || D(cur, j) < D(cur, best)))
+                {best = j;}
+        }
+        cand[cur][best] = 1;
+        used[best] = true;
+        cur = best;
+    }
+    if (n > 1)
+        {cand[cur][0] = 1;}
+}
+
+vector<vector<char>> candidateArcs(const ATSPDataC &data, int k, const LagrangianBound *lb){
+    int n = data.size;
+    vector<vector<char>> cand(n, vector<char>(n, 0));
+
+    if (lb && !lb->empty()){
+        auto rc = [&](int i, int j) { return lb->rc[static_cast<size_t>(i) * n + j]; };
+        int kk = min(k, n - 1);
+        vector<int> order;
+        for (int i = 0; i < n; ++i){
+            order.clear();
+            for (int j = 0; j < n; ++j)
+                {if (j != i) order.push_back(j);}
+            partial_sort(order.begin(), order.begin() + kk, order.end(), [&](int a, int b) { return rc(i, a) < rc(i, b); });
+            for (int t = 0; t < kk; ++t)
+                {cand[i][order[t]] = 1;}
+        }
+        addNearestIn(rc, n, k, cand);
+        for (size_t t = 0; t < lb->tour.size(); ++t)
+            {cand[lb->tour[t]][lb->tour[(t + 1) % lb->tour.size()]] = 1;}
+        return cand;
+    }
+
+    // sortants (coordonnees : k-d tree) ; metrique symetrique => entrants == sortants retournes
+    CandidateGraph out = nearestNeighborGraph(data, k);
+    for (int i = 0; i < n; ++i){
+        for (const int *j = out.begin(i); j != out.end(i); ++j){
+            cand[i][*j] = 1;
+            if (data.symmetric)
+                {cand[*j][i] = 1;}
+        }
+    }
+
+    data.visit([&](const auto &D){
+        if (!data.symmetric)
+            {addNearestIn(D, n, k, cand);}
+        addNearestNeighborTour(D, n, cand);
+    });
+    return cand;
+}
+
+double peakRssMB(){
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0){
+#ifdef __APPLE__
+        return usage.ru_maxrss / (1024.0 * 1024.0); // octets
+#else
+        return usage.ru_maxrss / 1024.0; // Ko
+#endif
+    }
+#endif
+    return -1.0;
+}
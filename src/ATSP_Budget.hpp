@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "ATSP_Data.hpp"
+#include "ATSP_Bound.hpp"
+
+using namespace std;
+
+// ======================================================================
+// ============== BUDGET MEMOIRE (estimation avant construction) ========
+// ======================================================================
+// ordres de grandeur seulement : Gurobi ne publie pas son empreinte exacte
+
+struct ModelSize{
+    long long vars; // colonnes
+    long long rows; // lignes a la construction (hors coupes)
+    long long nnz;  // non nuls a la construction
+    double memMB;   // memoire estimee (modele Gurobi + matrice distances + buffers du solveur)
+};
+
+// taille du modele pour mode (MTZ | MTZ_LAZY | CUT | CUT_LP | CUT_HYBRID | BOUND), oriente ou non
+// candidateK > 0 => modele oriente restreint aux arcs candidats (~ 2k + 1 arcs par sommet)
+ModelSize estimateModelSize(int n, const string &mode, bool symmetricModel, int threads, int candidateK = 0);
+
+// arcs candidats : k plus proches sortants + k plus proches entrants + tour plus proche voisin
+// (le tour garantit un cycle hamiltonien dans le graphe restreint)
+// lb non vide => k plus petits couts reduits sortants / entrants + tour de lb (arcs de l'optimum probables)
+vector<vector<char>> candidateArcs(const ATSPDataC &data, int k, const LagrangianBound *lb = nullptr);
+
+// pic de memoire residente du processus (Mo) ; -1 si indisponible
+double peakRssMB();
@@ -1,111 +1,120 @@
 #include "ATSP_CUT.hpp"
+#include "ATSP_Budget.hpp"
 #include <chrono>
+#include <cmath>
+#include <fstream>
+#include <set>
+#include <array>
 
 using namespace std;
 
 
-bool findSubtour_S(const vector<vector<double>> &sol, vector<int> &S){
-// ================= QUESTION 2 =================
-// * detecte sous tour dans solution int
-// * retourne S si contrainte (11) violee
-
-    int n = static_cast<int>(sol.size());
-    vector<bool> visited(n, false);
-    
-    // pour chaque sommet non visite
-    for (int start = 0; start < n; ++start){
-        if (visited[start]) // si le sommet est visité alrs skip le sommet
-            {continue;}
-
-        vector<int> cycle;
-        int current = start;
-
-        // suit arcs x[i][j] > 0.5 ; 0.5 car ~1 => choisi, tolerance numérique since it's double 1.9 is ~2 than 1  
-        while (!visited[current]){
-            visited[current] = true;
-            cycle.push_back(current);
-
-            bool foundNext = false;
-
-            for (int j = 0; j < n; ++j){
-                if (current != j && sol[current][j] > 0.5){
-                    current = j;
-                    foundNext = true;
-                    break;
-                }
-            }
-
-            if (!foundNext)
-                {break;}
-        }
-
-        // si cycle ferme && taille < n        
-        if (current == start && cycle.size() < n){
-            S = cycle; // sous tour trouve !!
-            return true;
-        }
+// termes de row (coefs[t] deja poses) -> vars ; arcs hors candidats retires (vars / coefs compactes)
+static int rowTerms(const vector<vector<GRBVar>> &x, const CutRow &row, vector<GRBVar> &vars, vector<double> &coefs,
+                    const vector<vector<char>> *candidate){
+    int nnz = row.nnz(), kept = 0;
+    vars.resize(nnz);
+    for (int t = 0; t < nnz; ++t){
+        int i = row.tails[t], j = row.heads[t];
+        if (candidate && !(*candidate)[i][j])
+            {continue;} // zeroArc partage : terme nul
+        vars[kept] = x[i][j];
+        coefs[kept++] = coefs[t];
     }
-
-    S.clear(); // pas sous tour && sanitize
-    return false;
+    return kept;
 }
 
-bool findFractionalCut_S(const vector<vector<double>> &sol, vector<int> &S){
-    int n = static_cast<int>(sol.size());
+GRBLinExpr cutRowExpr(const vector<vector<GRBVar>> &x, const CutRow &row, vector<GRBVar> &vars, vector<double> &coefs,
+                      const vector<vector<char>> *candidate){
+    coefs.assign(row.nnz(), 1.0);
+    int nnz = rowTerms(x, row, vars, coefs, candidate);
 
-    // construit matrice capacites cap = sol
-    double **cap = new double *[n];
-
-    for (int i = 0; i < n; ++i){
-        cap[i] = new double[n];
-        for (int j = 0; j < n; ++j)
-            {cap[i][j] = (i == j) ? 0.0 : sol[i][j];}
-    }
-
-    // pour chaque sink != 0
-    for (int sink = 1; sink < n; ++sink){
-        long *dist = new long[n];
-        double val = 0.0;
-
-        // calcule min cut 0 -> sink
-        directed_min_cut(cap, n, 0, sink, val, dist);
+    GRBLinExpr lhs = 0;
+    lhs.addTerms(coefs.data(), vars.data(), nnz);
+    return lhs;
+}
 
-        // si val < 1 => violation
-        if (val < 1.0 - 1e-6){ // 1e-6 => petite tolérance ; avoid the false-positive cases
-            S.clear(); // sanitizing
-            S.reserve(n); // sanitizing
+GRBLinExpr liftedCycleExpr(const vector<vector<GRBVar>> &x, const LiftedCycle &cut, CutRow &row,
+                           vector<GRBVar> &vars, vector<double> &coefs, const vector<vector<char>> *candidate){
+    liftedCycleTerms(cut, row.tails, row.heads, coefs);
+    row.sense = '<';
+    row.rhs = cut.rhs();
+    int nnz = rowTerms(x, row, vars, coefs, candidate);
 
-            // construit S depuis dist
-            for (int v = 0; v < n; ++v)
-               { if (dist[v] <= n - 1)
-                    {S.push_back(v);}
-                }
+    GRBLinExpr lhs = 0;
+    lhs.addTerms(coefs.data(), vars.data(), nnz);
+    return lhs;
+}
 
-            delete[] dist; // sanitizing
+// ---------------- point de reprise ----------------
+
+void CheckpointWriter::open(const string &path, double every, const Checkpoint &base, CutPool *pool,
+                            bool restricted){
+    lock_guard<mutex> guard(m);
+    this->path = path;
+    this->every = every;
+    this->pool = pool;
+    this->restricted = restricted;
+    state = base;
+    state.subtours.clear(); // coupes reprises deja dans le pool
+    state.lifted.clear();
+    baseElapsed = base.elapsed;
+    opened = last = std::chrono::steady_clock::now();
+}
 
-            for (int i = 0; i < n; ++i)
-                {delete[] cap[i];}
+void CheckpointWriter::offerTour(const vector<int> &tour, long long cost){
+    lock_guard<mutex> guard(m);
+    state.offerTour(tour, cost);
+}
 
-            delete[] cap; // sanitizing
+void CheckpointWriter::offerBound(double bound){
+    if (restricted || !(fabs(bound) < 1e100))
+        {return;} // arcs candidats / +/- GRB_INFINITY (pas encore de borne)
+    lock_guard<mutex> guard(m);
+    state.offerBound(bound);
+}
 
-            if (!S.empty() && static_cast<int>(S.size()) < n)
-                {return true;} // coupe trouve
+void CheckpointWriter::maybeWrite(){
+    if (!enabled())
+        {return;}
+    unique_lock<mutex> lock(io, try_to_lock); // un autre thread ecrit deja
+    if (!lock.owns_lock())
+        {return;}
+    if (std::chrono::duration<double>(std::chrono::steady_clock::now() - last).count() < every)
+        {return;}
+    writeNow();
+}
 
-            continue;
-        }
+bool CheckpointWriter::write(){
+    if (!enabled())
+        {return false;}
+    lock_guard<mutex> lock(io);
+    return writeNow();
+}
 
-        delete[] dist; // sanitizing
+bool CheckpointWriter::writeNow(){
+    Checkpoint c;
+    {
+        lock_guard<mutex> guard(m);
+        c = state;
     }
-
-    for (int i = 0; i < n; ++i)
-       { delete[] cap[i];} // sanitizing 
-
-    delete[] cap; // sanitizing
-
-    S.clear(); // pas de coupe
-    return false;
+    last = std::chrono::steady_clock::now();
+    c.elapsed = baseElapsed + std::chrono::duration<double>(last - opened).count();
+    if (pool)
+        {pool->snapshot(c.subtours, c.lifted);}
+    return writeCheckpoint(path, c);
 }
 
+static const char *modeName(ATSP_CUT::SolveMode mode){
+    switch (mode){
+    case ATSP_CUT::SolveMode::IntegerMIP:
+        return "CUT";
+    case ATSP_CUT::SolveMode::FractionalLP:
+        return "CUT_LP";
+    default:
+        return "CUT_HYBRID";
+    }
+}
 
 ATSP_CUT::ATSP_CUT(ATSPDataC data, SolveMode mode)
     : data(data), status(0), lazyCuts(0), userCuts(0), mode(mode) {}
@@ -114,10 +123,28 @@ void ATSP_CUT::solve(){
     try{
         lazyCuts = 0;
         userCuts = 0;
+        pool.clear();
+
+        stats.resetForSolve(); // garde lecture / estimation mesurees par l'appelant
+        long long buildStart = nowNs();
+
+        // --checkpoint : tour / borne / temps de la tranche precedente (--resume) repris, coupes via le pool
+        if (!checkpointFile.empty()){
+            Checkpoint base = (resume.n == data.size) ? resume : Checkpoint();
+            base.instance = data.name;
+            base.n = data.size;
+            base.fingerprint = instanceFingerprint(data);
+            base.mode = modeName(mode);
+            checkpoint.open(checkpointFile, params.checkpointEvery, base, &pool, params.candidateK > 0);
+        }
+        else
+            {checkpoint.close();}
 
-        env = std::make_unique<GRBEnv>(true);
-        env->set("LogFile", "atsp_cut.log");
-        env->start();
+        if (!env){
+            env = std::make_shared<GRBEnv>(true);
+            env->set("LogFile", "atsp_cut.log");
+            env->start();
+        }
 
         model = std::make_unique<GRBModel>(*env);
         GRBModel &modelRef = *model;
@@ -129,8 +156,36 @@ void ATSP_CUT::solve(){
         vector<GRBVar> u(data.size);
 
 
-        const char xType = (mode == SolveMode::FractionalLP) ? GRB_CONTINUOUS : GRB_BINARY; // int or double depending on the current mode
-        const char uType = (mode == SolveMode::FractionalLP) ? GRB_CONTINUOUS : GRB_INTEGER; // ""same""
+        // Hybrid : continues pour la boucle racine, passees en binaire / entier ensuite
+        const char xType = (mode == SolveMode::IntegerMIP) ? GRB_BINARY : GRB_CONTINUOUS; // int or double depending on the current mode
+        const char uType = (mode == SolveMode::IntegerMIP) ? GRB_INTEGER : GRB_CONTINUOUS; // ""same""
+
+        // arcs candidats (--mem-budget, --arc-elim) : arcs absents == 1 var nulle partagee
+        // => x[i][j] toujours valide dans les expr de coupes, pas de colonne par arc absent
+        candidate.clear();
+        const LagrangianBound *lagr = (params.arcElim && !lagrangian.empty()) ? &lagrangian : nullptr;
+        if (params.candidateK > 0)
+            {candidate = candidateArcs(data, params.candidateK, lagr);}
+
+        // --arc-elim : arcs hors de tout tour <= upper retires (optimum inchange, candidateK reste 0)
+        // le tour de reference est garde => graphe restreint toujours hamiltonien
+        if (lagr){
+            vector<vector<char>> keep = reducedCostArcs(*lagr, data.size, stats.arcsEliminated);
+            if (candidate.empty())
+                {candidate.swap(keep);}
+            else{
+                for (int i = 0; i < data.size; ++i)
+                    {for (int j = 0; j < data.size; ++j) candidate[i][j] = candidate[i][j] && keep[i][j];}
+                for (size_t t = 0; t < lagr->tour.size(); ++t)
+                    {candidate[lagr->tour[t]][lagr->tour[(t + 1) % lagr->tour.size()]] = 1;}
+            }
+        }
+        auto hasArc = [&](int i, int j) { return i != j && (candidate.empty() || candidate[i][j]); };
+        stats.candidateK = params.candidateK;
+
+        GRBVar zeroArc;
+        if (!candidate.empty())
+            {zeroArc = modelRef.addVar(0.0, 0.0, 0.0, GRB_CONTINUOUS, "x_absent");}
 
         for (int i = 0; i < data.size; ++i){
             // 1 <= u_i <= n-1 for i in N\{0}
@@ -140,8 +195,10 @@ void ATSP_CUT::solve(){
                 {u[i] = modelRef.addVar(0.0, 0.0, 0.0, uType, "u(" + to_string(i) + ")");}
 
             for (int j = 0; j < data.size; ++j){
-                if (i != j)
-                    {x[i][j] = modelRef.addVar(0.0, 1.0, data.distances[i][j], xType, "x(" + to_string(i) + "," + to_string(j) + ")");}
+                if (hasArc(i, j))
+                    {x[i][j] = modelRef.addVar(0.0, 1.0, data.dist(i, j), xType, "x(" + to_string(i) + "," + to_string(j) + ")");}
+                else if (i != j)
+                    {x[i][j] = zeroArc;}
             }
         }
 
@@ -149,8 +206,8 @@ void ATSP_CUT::solve(){
         GRBLinExpr obj = 0;
         for (int i = 0; i < data.size; ++i){
             for (int j = 0; j < data.size; ++j){
-                if (i != j)
-                    {obj += data.distances[i][j] * x[i][j];}
+                if (hasArc(i, j))
+                    {obj += data.dist(i, j) * x[i][j];}
             }
         }
         modelRef.setObjective(obj, GRB_MINIMIZE);
@@ -162,91 +219,424 @@ void ATSP_CUT::solve(){
         for (int i = 0; i < data.size; ++i){
             GRBLinExpr out = 0, 
                         in = 0;
-            for (int j = 0; j < data.size; ++j)
-                if (i != j){
-                    out += x[i][j];
-                    in += x[j][i];
-                }
+            for (int j = 0; j < data.size; ++j){
+                if (hasArc(i, j))
+                    {out += x[i][j];}
+                if (hasArc(j, i))
+                    {in += x[j][i];}
+            }
 
             modelRef.addConstr(out == 1);
             modelRef.addConstr(in == 1);
         }
 
-        modelRef.set(GRB_DoubleParam_TimeLimit, 180.0);
-        modelRef.set(GRB_IntParam_Threads, 1);
+        // sous tours courts poses d'avance (pool Lazy => pas dans le LP actif)
+        if (mode == SolveMode::IntegerMIP)
+            {seedSubtourCuts();}
+
+        // --resume : coupes de la tranche precedente => lignes, son tour => MIP start
+        if (resume.n == data.size){
+            for (const vector<int> &S : resume.subtours)
+                {pool.addSubtour(S);}
+            for (const LiftedCycle &cut : resume.lifted)
+                {pool.addLifted(cut);}
+            stats.seededCuts += flushPool();
+            if (mode != SolveMode::FractionalLP)
+                {setStartTour(resume.tour);}
+        }
+
+        modelRef.set(GRB_DoubleParam_TimeLimit, params.timeLimit);
+        modelRef.set(GRB_IntParam_Threads, params.threads);
+        stats.buildNs = nowNs() - buildStart;
 
         if (mode == SolveMode::IntegerMIP){
-            modelRef.set(GRB_IntParam_LazyConstraints, 1);
-            std::unique_ptr<ATSP_CUT_Callback> cb;
-            cb = std::unique_ptr<ATSP_CUT_Callback>(new ATSP_CUT_Callback(data.size, x, &lazyCuts, &userCuts));
-            modelRef.setCallback(cb.get());
-
-            modelRef.write("model.lp");
-            modelRef.optimize();
-            setterStatus(modelRef.get(GRB_IntAttr_Status));
+            branchAndCut(0.0);
         }
+        else if (mode == SolveMode::FractionalLP)
+            {cutLoop(params.timeLimit, 0.0, nullptr);}
         else{
+            // ================= HYBRIDE =================
+            // racine : boucle CUT_LP jusqu'au palier de borne ; coupes lachees retirees, coupes serrees gardees
             auto start = std::chrono::steady_clock::now();
-            double timeLimit = 180.0;
-
-            while(true){
-                auto now = std::chrono::steady_clock::now();
-                double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(now - start).count();
-                double remaining = timeLimit - elapsed;
-                
-                if (remaining <= 0.0)
-                    {break;}
+            vector<GRBConstr> rows;
+            int solved = 0;
+            {
+                ScopedTimer rootTimer(&stats.rootNs);
+                solved = cutLoop(ROOT_SHARE * params.timeLimit, params.tailOff, &rows);
+            }
+            // coupes lachees au dernier LP retirees ; dernier round non resolu (temps limite) => toutes gardees
+            int nRows = static_cast<int>(rows.size());
+            if (nRows > 0 && solved == nRows){
+                double *slack = modelRef.get(GRB_DoubleAttr_Slack, rows.data(), nRows);
+                for (int r = 0; r < nRows; ++r){
+                    if (fabs(slack[r]) > 1e-6)
+                        {modelRef.remove(rows[r]);}
+                    else
+                        {stats.rootKept++;}
+                }
+                delete[] slack;
+            }
+            else
+                {stats.rootKept = nRows;}
+
+            // x binaires, u entiers => meme modele que CUT (+ coupes racine) : lazy (MIPSOL) + user (MIPNODE)
+            for (int i = 0; i < data.size; ++i){
+                u[i].set(GRB_CharAttr_VType, GRB_INTEGER);
+                for (int j = 0; j < data.size; ++j){
+                    if (hasArc(i, j))
+                        {x[i][j].set(GRB_CharAttr_VType, GRB_BINARY);}
+                }
+            }
+            seedSubtourCuts();
 
+            // temps limite epuise par la racine => pas de branch-and-cut (modele entier non resolu)
+            double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+            double remaining = max(0.0, params.timeLimit - elapsed);
+            if (remaining > 0.0){
                 modelRef.set(GRB_DoubleParam_TimeLimit, remaining);
-                modelRef.optimize(); // optimise relax
-                setterStatus(modelRef.get(GRB_IntAttr_Status));
-
-                int status = getterStatus();
-                if (status != GRB_OPTIMAL && status != GRB_TIME_LIMIT)
-                    {break;}
-
-                // si pas sol => stop
-                if (modelRef.get(GRB_IntAttr_SolCount) == 0)
-                    {break;}
-
-                // reconstruit sol[i][j]
-                vector<vector<double>> sol(data.size, vector<double>(data.size, 0.0));
-                for (int i = 0; i < data.size; ++i){
-                    for (int j = 0; j < data.size; ++j){
-                        if (i != j){
-                            {sol[i][j] = x[i][j].get(GRB_DoubleAttr_X);}}}}
-
-                vector<int> S;
-                // cherche coupe violee
-                if (!findFractionalCut_S(sol, S))
-                   { break;} // aucune violation
-
-                // construit inS
-                vector<bool> inS(data.size, false);
-                for (int v : S)
-                    {inS[v] = true;}
-
-                // cut == sum i not in S j in S x[i][j]
-                GRBLinExpr cut = 0;
-                for (int i = 0; i < data.size; ++i){
-                    {if (!inS[i])
-                        {for (int j : S)
-                            {cut += x[i][j];}}}} 
-
-                modelRef.addConstr(cut >= 1); // ajoute user cut
-                userCuts++; // +1 compteur
-
-                if (getterStatus() == GRB_TIME_LIMIT)
-                    {break;}
+                branchAndCut(elapsed);
+            }
+            else{
+                modelRef.update();
+                setterStatus(GRB_TIME_LIMIT);
             }
+            stats.hybridNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
         }
+        finishCheckpoint();
     }
     catch (GRBException e){
-        cout << "Error code = " << e.getErrorCode() << endl;
-        cout << e.getMessage() << endl;
+        cerr << "Error code = " << e.getErrorCode() << endl;
+        cerr << e.getMessage() << endl;
     }
     catch (...)
-    {  cout << "Exception during optimization" << endl;}
+    {  cerr << "Exception during optimization" << endl;}
+}
+
+void ATSP_CUT::branchAndCut(double timeOffset){
+    GRBModel &modelRef = *model;
+    modelRef.set(GRB_IntParam_LazyConstraints, 1);
+    std::unique_ptr<ATSP_CUT_Callback> cb;
+    cb = std::unique_ptr<ATSP_CUT_Callback>(new ATSP_CUT_Callback(data.size, x, &lazyCuts, &userCuts, &stats,
+                                                           modelArcs(), &pool,
+                                                           checkpoint.enabled() ? &checkpoint : nullptr));
+    cb->setterTimeOffset(timeOffset);
+    modelRef.setCallback(cb.get());
+    {
+        ScopedTimer optTimer(&stats.optimizeNs);
+        modelRef.optimize();
+    }
+    modelRef.setCallback(nullptr); // cb detruit en sortie
+    setterStatus(modelRef.get(GRB_IntAttr_Status));
+}
+
+int ATSP_CUT::flushPool(){
+    GRBModel &modelRef = *model;
+    int added = 0;
+    CutRow row;
+    vector<GRBVar> rowVars;
+    vector<double> rowCoefs;
+    vector<char> inS;
+    for (; pool.subtoursInModel < pool.subtours.size(); ++pool.subtoursInModel){
+        sparsestSubtourRow(data.size, pool.subtours[pool.subtoursInModel], false, row, inS);
+        modelRef.addConstr(cutRowExpr(x, row, rowVars, rowCoefs, modelArcs()), row.sense, row.rhs);
+        added++;
+    }
+    for (; pool.liftedInModel < pool.lifted.size(); ++pool.liftedInModel){
+        const LiftedCycle &cut = pool.lifted[pool.liftedInModel];
+        modelRef.addConstr(liftedCycleExpr(x, cut, row, rowVars, rowCoefs, modelArcs()) <= cut.rhs());
+        added++;
+    }
+    return added;
+}
+
+void ATSP_CUT::setStartTour(const vector<int> &tour){
+    int n = data.size;
+    if (static_cast<int>(tour.size()) != n)
+        {return;}
+    for (int t = 0; t < n; ++t){
+        if (!candidate.empty() && !candidate[tour[t]][tour[(t + 1) % n]])
+            {return;} // arc retire du modele (arcs candidats / elimines)
+    }
+    for (int i = 0; i < n; ++i){
+        for (int j = 0; j < n; ++j){
+            if (i != j && (candidate.empty() || candidate[i][j]))
+                {x[i][j].set(GRB_DoubleAttr_Start, 0.0);}
+        }
+    }
+    for (int t = 0; t < n; ++t)
+        {x[tour[t]][tour[(t + 1) % n]].set(GRB_DoubleAttr_Start, 1.0);}
+}
+
+void ATSP_CUT::finishCheckpoint(){
+    if (!checkpoint.enabled())
+        {return;}
+    if (mode != SolveMode::FractionalLP){
+        vector<int> tour = getterTour();
+        if (!tour.empty())
+            {checkpoint.offerTour(tour, tourCost(data, tour));}
+        try
+            {checkpoint.offerBound(model->get(GRB_DoubleAttr_ObjBound));}
+        catch (GRBException e)
+            {} // pas de borne (aucun noeud resolu)
+    }
+    if (!checkpoint.write())
+        {cerr << "Point de reprise non ecrit : " << checkpointFile << endl;}
+}
+
+vector<int> ATSP_CUT::getterTour(){
+    vector<int> tour;
+    if (!model || mode == SolveMode::FractionalLP)
+        {return tour;}
+    try{
+        if (model->get(GRB_IntAttr_SolCount) == 0)
+            {return tour;}
+        int n = data.size;
+        vector<int> succ(n, -1);
+        for (int i = 0; i < n; ++i){
+            for (int j = 0; j < n; ++j){
+                if (i != j && x[i][j].get(GRB_DoubleAttr_X) > 0.5)
+                    {succ[i] = j;}
+            }
+        }
+        for (int v = 0; static_cast<int>(tour.size()) < n; v = succ[v]){
+            if (v < 0 || (!tour.empty() && v == 0))
+                {return vector<int>();} // pas un tour (sous tours)
+            tour.push_back(v);
+        }
+        if (succ[tour.back()] != 0)
+            {tour.clear();}
+    }
+    catch (GRBException e)
+        {tour.clear();}
+    return tour;
+}
+
+void ATSP_CUT::reoptimize(const vector<ArcCost> &changes){
+    if (!model){
+        cerr << "Fail -- run solve() first in the main" << endl;
+        return;
+    }
+    if (!candidate.empty()){
+        cerr << "Fail -- reoptimize sur un modele restreint (arcs candidats / --arc-elim)" << endl;
+        return;
+    }
+    try{
+        GRBModel &modelRef = *model;
+        vector<int> tour = getterTour(); // avant modification (sol effacee ensuite)
+        checkpoint.close(); // couts modifies : empreinte du point de reprise perimee
+
+        lazyCuts = 0;
+        userCuts = 0;
+        stats.resetForSolve();
+        long long buildStart = nowNs();
+
+        // couts : modele modifie sur place => Gurobi repart de la derniere base
+        for (const ArcCost &c : changes){
+            if (c.i == c.j || c.i < 0 || c.j < 0 || c.i >= data.size || c.j >= data.size)
+                {continue;}
+            data.updateWeight(c.i, c.j, c.cost);
+            x[c.i][c.j].set(GRB_DoubleAttr_Obj, static_cast<double>(c.cost));
+        }
+
+        // coupes du callback (perdues par Gurobi) => lignes ; CUT_LP : deja lignes du modele
+        stats.seededCuts = flushPool();
+
+        // tour precedent toujours realisable (contraintes inchangees) => MIP start
+        setStartTour(tour);
+        stats.buildNs = nowNs() - buildStart;
+
+        modelRef.set(GRB_DoubleParam_TimeLimit, params.timeLimit);
+        if (mode == SolveMode::FractionalLP)
+            {cutLoop(params.timeLimit, 0.0, nullptr);}
+        else
+            {branchAndCut(0.0);}
+    }
+    catch (GRBException e){
+        cerr << "Error code = " << e.getErrorCode() << endl;
+        cerr << e.getMessage() << endl;
+    }
+    catch (...)
+    {  cerr << "Exception during optimization" << endl;}
+}
+
+int ATSP_CUT::cutLoop(double timeLimit, double tailOff, vector<GRBConstr> *rows){
+    GRBModel &modelRef = *model;
+    auto start = std::chrono::steady_clock::now();
+    int solved = 0;                   // coupes de rows presentes au dernier optimize()
+    double lastBound = -GRB_INFINITY; // borne LP du round precedent
+    int flatRounds = 0;               // rounds de suite a gain <= tailOff
+
+    ofstream points; // points LP enregistres (optionnel)
+    if (!pointsFile.empty())
+        {points.open(pointsFile);}
+
+    WarmMinCut warmFlow; // flots (0, puits) repris d'un round a l'autre
+
+    // x[i][j] i != j a plat => point du round en 1 seul get (sol alloue 1 fois)
+    int n = data.size;
+    vector<GRBVar> arcs;
+    arcs.reserve(static_cast<size_t>(n) * (n - 1));
+    for (int i = 0; i < n; ++i)
+        {for (int j = 0; j < n; ++j)
+            {if (i != j) arcs.push_back(x[i][j]);}}
+    vector<vector<double>> sol(n, vector<double>(n, 0.0));
+    vector<int> S;
+    CutRow row;
+    vector<GRBVar> rowVars;
+    vector<double> rowCoefs;
+    vector<char> inS;
+
+    while(true){
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(now - start).count();
+        double remaining = timeLimit - elapsed;
+        
+        if (remaining <= 0.0)
+            {break;}
+
+        modelRef.set(GRB_DoubleParam_TimeLimit, remaining);
+        {
+            ScopedTimer optTimer(&stats.optimizeNs);
+            modelRef.optimize(); // optimise relax
+        }
+        setterStatus(modelRef.get(GRB_IntAttr_Status));
+        if (rows)
+            {solved = static_cast<int>(rows->size());}
+
+        // trajectoire : borne LP du round (pas d'incumbent entier)
+        if (modelRef.get(GRB_IntAttr_SolCount) > 0){
+            double lpTime = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+            stats.addTrajectory(lpTime, GRB_INFINITY, modelRef.get(GRB_DoubleAttr_ObjVal));
+            if (rows)
+                {stats.rootBound = modelRef.get(GRB_DoubleAttr_ObjVal);}
+        }
+
+        int status = getterStatus();
+        if (status == GRB_OPTIMAL && modelRef.get(GRB_IntAttr_SolCount) > 0)
+            {checkpoint.offerBound(modelRef.get(GRB_DoubleAttr_ObjVal));} // LP resolu == borne valide
+        checkpoint.maybeWrite();
+        if (status != GRB_OPTIMAL && status != GRB_TIME_LIMIT)
+            {break;}
+
+        // si pas sol => stop
+        if (modelRef.get(GRB_IntAttr_SolCount) == 0)
+            {break;}
+
+        // palier de borne (tailing off) => stop avant de separer (slacks du dernier LP valides)
+        if (tailOff > 0.0){
+            double bound = modelRef.get(GRB_DoubleAttr_ObjVal);
+            if (bound - lastBound <= tailOff * max(1.0, fabs(bound)))
+                {flatRounds++;}
+            else
+                {flatRounds = 0;}
+            lastBound = bound;
+            if (flatRounds >= TAIL_ROUNDS)
+                {break;}
+        }
+
+        // reconstruit sol[i][j] (l'API C++ renvoie un tableau alloue par new[] => 1 delete[] par round)
+        double *vals = modelRef.get(GRB_DoubleAttr_X, arcs.data(), static_cast<int>(arcs.size()));
+        for (int i = 0, k = 0; i < n; ++i)
+            {for (int j = 0; j < n; ++j)
+                {if (i != j) sol[i][j] = vals[k++];}}
+        delete[] vals;
+
+        if (points.is_open())
+            {savePoint(points, sol);}
+
+        double violation = 0.0;
+        // cherche coupe violee : sous tour puis D_k+/-
+        if (findFractionalCut_S(sol, S, &stats, &violation, &warmFlow)){
+            // cut (11) sous la forme la plus creuse
+            sparsestSubtourRow(n, S, false, row, inS);
+            GRBConstr c = modelRef.addConstr(cutRowExpr(x, row, rowVars, rowCoefs, modelArcs()), row.sense, row.rhs); // ajoute user cut
+            if (rows)
+                {rows->push_back(c);}
+            pool.addSubtour(S); // deja ligne du modele (point de reprise)
+            pool.subtoursInModel = pool.subtours.size();
+            userCuts++; // +1 compteur
+            stats.addCut(violation);
+            stats.addRound(1);
+        }
+        else{
+            vector<LiftedCycle> cuts;
+            if (findLiftedCycles(sol, cuts) == 0)
+                {break;} // aucune violation
+
+            for (const LiftedCycle &cut : cuts){
+                GRBConstr c = modelRef.addConstr(liftedCycleExpr(x, cut, row, rowVars, rowCoefs, modelArcs()) <= cut.rhs()); // ajoute D_k
+                if (rows)
+                    {rows->push_back(c);}
+                pool.addLifted(cut);
+                pool.liftedInModel = pool.lifted.size();
+                userCuts++;
+                stats.addCut(cut.violation);
+            }
+            stats.addRound(static_cast<int>(cuts.size()));
+        }
+
+        if (getterStatus() == GRB_TIME_LIMIT)
+            {break;}
+    }
+    return solved;
+}
+
+// triangles {i,j,l} avec j,l parmi les k plus proches voisins de i (d_ij + d_ji)
+// (1 instanciation par type de poids, cf. ATSPDataC::visit)
+template <typename Matrix>
+static vector<array<int, 3>> nearTriangles(const Matrix &D, int n, int k){
+    set<array<int, 3>> triangles;
+    vector<int> order(n);
+    for (int i = 0; i < n; ++i){
+        for (int j = 0; j < n; ++j)
+            {order[j] = j;}
+        order.erase(order.begin() + i);
+        auto cost = [&](int j) { return static_cast<long long>(D(i, j)) + D(j, i); };
+        int kk = min(k, n - 1);
+        partial_sort(order.begin(), order.begin() + kk, order.end(),
+                     [&](int a, int b) { return cost(a) < cost(b); });
+
+        for (int a = 0; a < kk; ++a){
+            for (int b = a + 1; b < kk; ++b){
+                array<int, 3> t = {i, order[a], order[b]};
+                sort(t.begin(), t.end());
+                triangles.insert(t);
+            }
+        }
+    }
+    return vector<array<int, 3>>(triangles.begin(), triangles.end());
+}
+
+void ATSP_CUT::seedSubtourCuts(){
+    GRBModel &modelRef = *model;
+    int n = data.size;
+    CutRow row;
+    vector<GRBVar> rowVars;
+    vector<double> rowCoefs;
+    vector<char> inS;
+
+    // Lazy == 3 : tire dans le LP racine des qu'il est viole
+    if (params.seedTwoCycles && n >= 3){
+        for (int i = 0; i < n; ++i){
+            for (int j = i + 1; j < n; ++j){
+                sparsestSubtourRow(n, vector<int>{i, j}, false, row, inS); // x_ij + x_ji <= 1
+                GRBConstr c = modelRef.addConstr(cutRowExpr(x, row, rowVars, rowCoefs, modelArcs()), row.sense, row.rhs);
+                c.set(GRB_IntAttr_Lazy, 3);
+                stats.seededCuts++;
+            }
+        }
+    }
+
+    // Lazy == 1 : seulement pour couper des sol entieres
+    if (params.seedTriangles >= 2 && n >= 4){ // S == V sinon
+        vector<array<int, 3>> triangles = data.visit([&](const auto &D) { return nearTriangles(D, n, params.seedTriangles); });
+        for (const array<int, 3> &t : triangles){
+            sparsestSubtourRow(n, vector<int>{t[0], t[1], t[2]}, false, row, inS); // x(A(S)) <= 2
+            GRBConstr c = modelRef.addConstr(cutRowExpr(x, row, rowVars, rowCoefs, modelArcs()), row.sense, row.rhs);
+            c.set(GRB_IntAttr_Lazy, 1);
+            stats.seededCuts++;
+        }
+    }
 }
 
 void ATSP_CUT::printSolution()
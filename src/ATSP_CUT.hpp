@@ -1,14 +1,96 @@
 #pragma once
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
 #include "gurobi_c++.h"
 #include "ATSP_Data.hpp"
-#include "hi_pr.hpp"
+#include "ATSP_MaxFlow.hpp"
+#include "ATSP_Stats.hpp"
+#include "ATSP_Sep.hpp"
+#include "ATSP_Params.hpp"
+#include "ATSP_Bound.hpp"
+#include "ATSP_Checkpoint.hpp"
 
-// detecte 1 sous tour dans sol => remplit S si trouve
-bool findSubtour_S(const std::vector<std::vector<double>> &sol, std::vector<int> &S);
+// ======================================================================
+// ============== POOL DE COUPES (callback => re-solves) ================
+// ======================================================================
+// coupes lazy (MIPSOL) / user (MIPNODE) du callback : Gurobi ne les garde pas dans le modele apres
+// optimize() => copiees ici, reposees en lignes avant un re-solve (reoptimize) ; valides quels que soient les couts
+struct CutPool{
+    vector<vector<int>> subtours; // S trie : x(delta-(S)) >= 1 (forme creuse a la pose)
+    vector<LiftedCycle> lifted;   // D_k+/-
+    size_t subtoursInModel = 0;   // [0, subtoursInModel) deja lignes du modele
+    size_t liftedInModel = 0;
+
+    void addSubtour(vector<int> S){
+        sort(S.begin(), S.end());
+        lock_guard<mutex> guard(m);
+        if (seen.insert(S).second)
+            {subtours.push_back(S);}
+    }
+
+    void clear(){
+        lock_guard<mutex> guard(m);
+        subtours.clear();
+        lifted.clear();
+        seen.clear();
+        seenLifted.clear();
+        subtoursInModel = liftedInModel = 0;
+    }
+
+    void addLifted(const LiftedCycle &cut){
+        lock_guard<mutex> guard(m);
+        if (seenLifted.insert(make_pair(cut.seq, cut.plus)).second)
+            {lifted.push_back(cut);}
+    }
+
+    // copie coherente pendant optimize() (point de reprise)
+    void snapshot(vector<vector<int>> &subtoursOut, vector<LiftedCycle> &liftedOut){
+        lock_guard<mutex> guard(m);
+        subtoursOut = subtours;
+        liftedOut = lifted;
+    }
+
+private:
+    mutex m; // callback multi thread
+    set<vector<int>> seen;
+    set<pair<vector<int>, bool>> seenLifted;
+};
+
+// ======================================================================
+// ============== POINT DE REPRISE PERIODIQUE (--checkpoint) ============
+// ======================================================================
+// meilleur tour / borne de la tranche + pool => fichier toutes les params.checkpointEvery secondes
+// appele depuis le callback (threads Gurobi) : etat sous verrou, 1 seul ecrivain (try_lock, jamais bloquant)
+class CheckpointWriter{
+public:
+    // base == instance + etat de la tranche precedente (--resume) ; pool recopie a chaque ecriture
+    // restricted == arcs candidats : bornes du modele restreint, pas de l'instance => ignorees
+    void open(const string &path, double every, const Checkpoint &base, CutPool *pool, bool restricted);
+    void close() { path.clear(); }
+    bool enabled() const { return !path.empty(); }
 
-static bool findFractionalCut_S(const vector<vector<double>> &sol, vector<int> &S);
+    void offerTour(const vector<int> &tour, long long cost);
+    void offerBound(double bound); // ignoree si infinie ou modele restreint
+    void maybeWrite();             // si every secondes depuis la derniere ecriture
+    bool write();                  // maintenant (fin de solve)
+
+private:
+    string path;
+    double every = 0.0;
+    Checkpoint state;
+    double baseElapsed = 0.0;
+    CutPool *pool = nullptr;
+    bool restricted = false;
+    std::chrono::steady_clock::time_point opened, last;
+    mutex m;  // state
+    mutex io; // fichier
+
+    bool writeNow(); // io tenu
+};
 
 // ======================================================================
 // ============== CLASS ATSP_CUT :: GRBCALLBACK =========================
@@ -16,24 +98,67 @@ static bool findFractionalCut_S(const vector<vector<double>> &sol, vector<int> &
 class ATSP_CUT : public GRBCallback{
 private:
     ATSPDataC data;
-    std::unique_ptr<GRBEnv> env;
+    std::shared_ptr<GRBEnv> env; // propre au solveur, ou partage (setterEnv, --serve)
     std::unique_ptr<GRBModel> model;
     int status;
 
     vector<vector<GRBVar>> x; // x[i][j] == var decision arc i->j
 
-    int lazyCuts; // nb lazy cuts ajoutees
-    int userCuts; // "  user   "     "
+    atomic<int> lazyCuts; // nb lazy cuts ajoutees (atomique : callback multi thread)
+    atomic<int> userCuts; // "  user   "     "
+
+    SolveStats stats; // instrumentation
+
+    string pointsFile; // si != "" => enregistre chaque point LP (CUT_LP) pour TSP_bench
+
+    SolverParams params; // threads, temps limite
+
+    vector<vector<char>> candidate; // arcs candidats (params.candidateK > 0) et / ou non elimines (params.arcElim), vide == complet
+
+    LagrangianBound lagrangian; // borne 1-arborescence (params.arcElim : elimination + classement des candidats)
+
+    CutPool pool; // coupes du callback, reposees par reoptimize
+
+    string checkpointFile;       // --checkpoint (vide == pas de point de reprise)
+    Checkpoint resume;           // --resume (n == 0 == pas de reprise)
+    CheckpointWriter checkpoint; // ouvert par solve() si checkpointFile
 
 public:
     enum class SolveMode{
-        IntegerMIP,  // solve entier
-        FractionalLP // solve frac (relax LP)
+        IntegerMIP,   // solve entier
+        FractionalLP, // solve frac (relax LP)
+        Hybrid        // boucle de coupes LP a la racine, puis solve entier avec les coupes serrees
     };
 
+    // Hybrid : boucle racine arretee apres TAIL_ROUNDS rounds de suite a gain de borne <= params.tailOff,
+    // et au plus ROOT_SHARE du temps limite (le reste pour le branch-and-cut)
+    static const int TAIL_ROUNDS = 3;
+    static constexpr double ROOT_SHARE = 0.5;
+
 private:
     SolveMode mode; // mode courant (int or double)
 
+    void seedSubtourCuts(); // 2-cycles / triangles proches (params) dans le pool Lazy
+
+    // arcs du modele pour cutRowExpr / liftedCycleExpr (nullptr == graphe complet)
+    const vector<vector<char>> *modelArcs() const { return candidate.empty() ? nullptr : &candidate; }
+
+    // boucle LP + separation (CUT_LP, racine de Hybrid) ; tailOff > 0 => arret sur palier de borne
+    // rows != nullptr => coupes ajoutees ; renvoie le nb de ces coupes presentes au dernier optimize()
+    int cutLoop(double timeLimit, double tailOff, vector<GRBConstr> *rows);
+
+    // callback lazy (MIPSOL) + user (MIPNODE) puis optimize() ; timeOffset == secondes deja ecoulees (trajectoire)
+    void branchAndCut(double timeOffset);
+
+    // coupes du pool pas encore dans le modele => lignes ; renvoie le nb ajoute
+    int flushPool();
+
+    // MIP start == tour (ignore si un de ses arcs manque au modele)
+    void setStartTour(const vector<int> &tour);
+
+    // fin de solve : tour / borne du modele => point de reprise ecrit
+    void finishCheckpoint();
+
 public:
     // Setters & Getters
     void setterX(vector<vector<GRBVar>> &x) { this->x = x; }
@@ -45,73 +170,200 @@ public:
     int getUserCuts() const { return userCuts; }
     int getTotalCuts() const { return lazyCuts + userCuts; } // total cuts (user + lazy)
     SolveMode getMode() const { return mode; }
+    SolveStats &getterStats() { return stats; }
+    void setterPointsFile(const string &pointsFile) { this->pointsFile = pointsFile; }
+    void setterParams(const SolverParams &params) { this->params = params; }
+    void setterEnv(const std::shared_ptr<GRBEnv> &env) { this->env = env; } // avant solve() : pas de demarrage d'env
+    void setterLagrangian(const LagrangianBound &lagrangian) { this->lagrangian = lagrangian; }
+    void setterCheckpointFile(const string &checkpointFile) { this->checkpointFile = checkpointFile; }
+    void setterResume(const Checkpoint &resume) { this->resume = resume; } // n == data.size (verifie par l'appelant)
 
     // Constructeur
     ATSP_CUT(ATSPDataC data, SolveMode mode = SolveMode::IntegerMIP);
 
     void solve();         // build + solve model
     void printSolution(); // affiche sol
+
+    // apres solve() : nouveaux couts sur le modele existant puis re-solve (meme mode)
+    // garde les coupes (lignes du modele + pool du callback), la base LP de Gurobi et le dernier tour (MIP start)
+    // arcs absents du modele (--mem-budget, --arc-elim) : choisis d'apres les anciens couts => refuse
+    void reoptimize(const vector<ArcCost> &changes);
+
+    // successeurs depuis 0 de la derniere sol entiere ; vide si pas de tour (CUT_LP, pas de sol)
+    vector<int> getterTour();
+    const CutPool &getterPool() const { return pool; }
+};
+
+// ligne creuse -> expr Gurobi (addTerms depuis les tableaux vars / coefs, reutilises)
+// candidate != nullptr => arcs hors candidats (x == zeroArc, fixe a 0) omis
+GRBLinExpr cutRowExpr(const vector<vector<GRBVar>> &x, const CutRow &row, vector<GRBVar> &vars, vector<double> &coefs,
+                      const vector<vector<char>> *candidate = nullptr);
+
+// D_k+/- == cycle + arcs releves (<= cut.rhs()) ; termes dans row / vars / coefs (reutilises, cf. cutRowExpr)
+GRBLinExpr liftedCycleExpr(const vector<vector<GRBVar>> &x, const LiftedCycle &cut, CutRow &row,
+                           vector<GRBVar> &vars, vector<double> &coefs, const vector<vector<char>> *candidate = nullptr);
+
+// buffers de separation d'un thread (alloues au 1er appel du thread, puis reutilises)
+struct CutScratch{
+    long owner = -1;             // id du callback qui les a dimensionnes
+    vector<GRBVar> arcs;         // x[i][j] i != j a plat (ordre ligne, arcs presents)
+    vector<int> arcTail;         // i de arcs[k]
+    vector<int> arcHead;         // j de arcs[k]
+    FlatPoint sol;               // point courant n x n a plat (diagonale == 0)
+    PushRelabel flow;            // max flow CSR du point courant (reconstruit a chaque MIPNODE)
+    vector<int> S;               // cote S de la coupe
+    CutRow row;                  // coupe (11) creuse
+    vector<GRBVar> rowVars;      // vars de row (addTerms)
+    vector<double> rowCoefs;     // coefs de row (== 1)
+    vector<char> inS;            // marquage de S (sparsestSubtourRow)
+    vector<LiftedCycle> lifted;  // D_k+/- du point (MIPNODE sans sous tour)
+    LiftedScratch liftedWork;    // buffers de findLiftedCycles
+    vector<int> tour;            // tour du MIPSOL (--checkpoint)
+
+    // candidate != nullptr => seulement les arcs candidats (sol == 0 ailleurs)
+    void init(long id, int n, const vector<vector<GRBVar>> &x, const vector<vector<char>> *candidate){
+        owner = id;
+        arcs.clear();
+        arcTail.clear();
+        arcHead.clear();
+        sol.assign(n);
+        S.clear();
+        S.reserve(n);
+        tour.reserve(n);
+        for (int i = 0; i < n; ++i){
+            for (int j = 0; j < n; ++j){
+                if (i != j && (!candidate || (*candidate)[i][j])){
+                    arcs.push_back(x[i][j]);
+                    arcTail.push_back(i);
+                    arcHead.push_back(j);
+                }
+            }
+        }
+    }
 };
 
 // ======================================================================
 // ============== CLASS ATSP_CUT_CALLBACK :: GRBCALLBACK ================
 // ======================================================================
+// Threads > 1 : compteurs atomiques, stats sous verrou, buffers + max flow par thread
 class ATSP_CUT_Callback : public GRBCallback{
 private:
     int n;                     // taille instance
     vector<vector<GRBVar>> &x; // ref vars x
 
-    int *lazyCuts; // ptr comptaur lazy
-    int *userCuts; //  "     "     user
+    atomic<int> *lazyCuts; // ptr comptaur lazy
+    atomic<int> *userCuts; //  "     "     user
+
+    SolveStats *stats; // instrumentation (optionnel)
+
+    const vector<vector<char>> *candidate; // arcs candidats (nullptr == graphe complet)
+
+    double timeOffset = 0.0; // secondes avant optimize() (Hybrid : boucle racine) => trajectoire continue
+
+    CutPool *pool; // coupes ajoutees recopiees (nullptr == pas de pool)
+
+    CheckpointWriter *checkpoint; // tours / bornes => point de reprise (nullptr == pas de --checkpoint)
+
+    long id; // identifiant unique => buffers thread_local redimensionnes si autre callback
+
+    static long nextId(){
+        static atomic<long> counter(0);
+        return counter++;
+    }
 
 public:
-    ATSP_CUT_Callback(int n, vector<vector<GRBVar>> &x, int *lazyCuts, int *userCuts)
-        : n(n), x(x), lazyCuts(lazyCuts), userCuts(userCuts) {}
+    ATSP_CUT_Callback(int n, vector<vector<GRBVar>> &x, atomic<int> *lazyCuts, atomic<int> *userCuts,
+                      SolveStats *stats = nullptr, const vector<vector<char>> *candidate = nullptr,
+                      CutPool *pool = nullptr, CheckpointWriter *checkpoint = nullptr)
+        : n(n), x(x), lazyCuts(lazyCuts), userCuts(userCuts), stats(stats), candidate(candidate), pool(pool),
+          checkpoint(checkpoint), id(nextId()) {}
+
+    void setterTimeOffset(double timeOffset) { this->timeOffset = timeOffset; }
+
+private:
+    // buffers du thread courant (1 allocation par thread et par callback)
+    CutScratch &scratch(){
+        thread_local CutScratch w;
+        if (w.owner != id)
+            {w.init(id, n, x, candidate);}
+        return w;
+    }
+
+    // recupere le point MIPSOL / MIPNODE en 1 seul appel Gurobi => w.sol
+    // (l'API C++ renvoie un tableau alloue par new[] => 1 delete[] par appel)
+    void fetchPoint(CutScratch &w){
+        int nArcs = static_cast<int>(w.arcs.size());
+        double *vals = (where == GRB_CB_MIPSOL) ? getSolution(w.arcs.data(), nArcs)
+                                                : getNodeRel(w.arcs.data(), nArcs);
+        for (int k = 0; k < nArcs; ++k)
+            {w.sol[w.arcTail[k]][w.arcHead[k]] = vals[k];}
+        delete[] vals;
+    }
 
 protected:
     void callback(){
+        // trajectoire incumbent / borne
+        if (where == GRB_CB_MIP){
+            if (stats){
+                try{
+                    stats->addTrajectory(timeOffset + getDoubleInfo(GRB_CB_RUNTIME), getDoubleInfo(GRB_CB_MIP_OBJBST),
+                                         getDoubleInfo(GRB_CB_MIP_OBJBND));
+                }
+                catch (GRBException e)
+                    { cerr << "Erreur callback : " << e.getMessage() << endl; }
+            }
+            if (checkpoint){
+                try{
+                    checkpoint->offerBound(getDoubleInfo(GRB_CB_MIP_OBJBND));
+                    checkpoint->maybeWrite();
+                }
+                catch (GRBException e)
+                    { cerr << "Erreur callback : " << e.getMessage() << endl; }
+            }
+            return;
+        }
+
+        if (where != GRB_CB_MIPSOL && where != GRB_CB_MIPNODE)
+            {return;} // rien a separer
+
+        ScopedTimer timer(stats ? &stats->callbackNs : nullptr, stats);
+        if (stats)
+            {stats->add(stats->callbackCalls, 1);}
+
         try{
+            CutScratch &w = scratch(); // buffers du thread courant
+            const FlatPoint &sol = w.sol;
+            vector<int> &S = w.S;
+
             // ================= QUESTION 3 =================
             // sep contraintes (11) sol int
             // si sol entiere trouvee
             if (where == GRB_CB_MIPSOL){
 
-                // reconstruit matrice sol[i][j]
-                vector<vector<double>> sol(n, vector<double>(n, 0.0));
-                for (int i = 0; i < n; ++i)
-                    {for (int j = 0; j < n; ++j)
-                        {if (i != j)
-                            {sol[i][j] = getSolution(x[i][j]);}}}
-
-                vector<int> S;
+                fetchPoint(w); // sol[i][j]
 
                 // cherche sous tour
                 if (findSubtour_S(sol, S)){
 
-                    // construit indicateur inS
-                    vector<bool> inS(n, false);
-                    for (int v : S)
-                        {inS[v] = true;}
-
-                    GRBLinExpr cut = 0;
-
-                    // cut == sum i notin S j in S x[i][j]
-                    for (int i = 0; i < n; ++i){
-                        if (!inS[i]){
-                            for (int j : S)
-                            { cut += x[i][j];}}
-                    }
-
-                    addLazy(cut >= 1); // ajoute lazy cut (contrainte (11))
+                    // cut (11) sous la forme la plus creuse
+                    sparsestSubtourRow(n, S, false, w.row, w.inS);
+                    addLazy(cutRowExpr(x, w.row, w.rowVars, w.rowCoefs, candidate), w.row.sense, w.row.rhs);
+                    if (pool)
+                        {pool->addSubtour(S);}
                     if (lazyCuts)
                         {(*lazyCuts)++;} // +1 compteur
+                    if (stats){
+                        stats->addCut(rowViolation(sol, w.row));
+                        stats->addRound(1);
+                    }
 
                     return; // 1 coupe suffit
                 }
-            }
 
-            if (where == GRB_CB_MIPSOL)
-                { cout << "SKIPPED CALLBACK ON MIPSOL" << endl; }
+                // tour (pas de sous tour) => nouvel incumbent
+                if (checkpoint && tourFromSolution(sol, w.tour))
+                    {checkpoint->offerTour(w.tour, llround(getDoubleInfo(GRB_CB_MIPSOL_OBJ)));}
+            }
 
             // ================= QUESTION 5 =================
             // sep contraintes (11) sol frac via min cut
@@ -120,78 +372,75 @@ protected:
                 if (getIntInfo(GRB_CB_MIPNODE_STATUS) != GRB_OPTIMAL)
                     {return;} // sinon stop
 
-                // reconstruit sol frac x[i][j]
-                vector<vector<double>> sol(n, vector<double>(n, 0.0));
-                for (int i = 0; i < n; ++i){
-                    for (int j = 0; j < n; ++j){
-                        if (i != j)
-                            {sol[i][j] = getNodeRel(x[i][j]);}
-                    }
-                }
+                fetchPoint(w); // sol frac x[i][j]
 
-                // cap[i][j] == sol[i][j]
-                double **cap = new double *[n];
-                for (int i = 0; i < n; ++i){
-                    cap[i] = new double[n];
-                    
-                    for (int j = 0; j < n; ++j)
-                        { cap[i][j] = (i == j) ? 0.0 : sol[i][j]; }
+                // graphe support du point (arcs sol > EPS), reutilise pour tous les puits
+                {
+                    ScopedTimer mfTimer(stats ? &stats->maxflowNs : nullptr, stats);
+                    w.flow.build(sol);
                 }
 
+                bool cutAdded = false;        // coupe sous tour ajoutee
+
                 // test min cut 0 -> sink
                 for (int sink = 1; sink < n; ++sink){
-                    long *dist = new long[n]; // labels coupe
-                    double val = 0.0;         // valeur min cut
+                    double val = 0.0; // valeur min cut
 
-                    directed_min_cut(cap, n, 0, sink, val, dist); // calcule min cut
+                    {
+                        ScopedTimer mfTimer(stats ? &stats->maxflowNs : nullptr, stats);
+                        val = w.flow.minCut(0, sink); // calcule min cut
+                    }
+                    if (stats)
+                        {stats->add(stats->maxflowCalls, 1);}
 
                     // si val < 1 => contrainte (11) violee
                     if (val < 1.0 - 1e-6){
-                        vector<int> S; // ensemble cote source
-                        S.reserve(n);
-
-                        // construit S depuis dist
+                        // construit S (cote puits)
+                        S.clear();
                         for (int v = 0; v < n; ++v){
-                            if (dist[v] <= n - 1)
+                            if (w.flow.inSinkSide(v))
                                 { S.push_back(v); }
                         }
 
                         // si trivial => ignore
-                        if (S.empty() || static_cast<int>(S.size()) == n) {
-                            delete[] dist; // sanitize
-                            continue;
-                        }
-
-                        vector<bool> inS(n, false); // indicateur S
-                        for (int v : S)
-                            {inS[v] = true; }
-
-                        // cut == sum i notin S j in S x[i][j]
-                        GRBLinExpr cut = 0;
-                        for (int i = 0; i < n; ++i) {
-                            if (!inS[i]) {
-                                for (int j : S)
-                                    { cut += x[i][j]; }
-                            }
-                        }
-
-                        addCut(cut >= 1); // ajoute user cut
+                        if (S.empty() || static_cast<int>(S.size()) == n)
+                            {continue;}
+
+                        // cut (11) sous la forme la plus creuse
+                        sparsestSubtourRow(n, S, false, w.row, w.inS);
+                        addCut(cutRowExpr(x, w.row, w.rowVars, w.rowCoefs, candidate), w.row.sense, w.row.rhs); // ajoute user cut
+                        if (pool)
+                            {pool->addSubtour(S);}
                         if (userCuts)
                             { (*userCuts)++;} // add +1 to user cut compteur
-                        delete[] dist; // sanitize
-                        break;         // 1 coupe suffit
+                        if (stats){
+                            stats->addCut(1.0 - val);
+                            stats->addRound(1);
+                        }
+                        cutAdded = true;
+                        break; // 1 coupe suffit
                     }
-
-                    delete[] dist; // sanitize
                 }
 
-                for (int i = 0; i < n; ++i)
-                    { delete[] cap[i]; } // sanitize
-
-                delete[] cap; // sanitize
+                // pas de sous tour viole => D_k+/- releves
+                if (!cutAdded){
+                    vector<LiftedCycle> &cuts = w.lifted;
+                    findLiftedCycles(sol, cuts, w.liftedWork);
+                    for (const LiftedCycle &cut : cuts){
+                        addCut(liftedCycleExpr(x, cut, w.row, w.rowVars, w.rowCoefs, candidate) <= cut.rhs());
+                        if (pool)
+                            {pool->addLifted(cut);}
+                        if (userCuts)
+                            { (*userCuts)++;}
+                        if (stats)
+                            {stats->addCut(cut.violation);}
+                    }
+                    if (stats)
+                        {stats->addRound(static_cast<int>(cuts.size()));}
+                }
             }
         }
         catch (GRBException e)
-            { cout << "Erreur callback : " << e.getMessage() << endl; }
+            { cerr << "Erreur callback : " << e.getMessage() << endl; }
     }
 };
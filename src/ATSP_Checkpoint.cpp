@@ -0,0 +1,187 @@
+#include "ATSP_Checkpoint.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+static const char *MAGIC = "ATSP_CHECKPOINT";
+static const int VERSION = 1;
+
+unsigned long long instanceFingerprint(const ATSPDataC &data){
+    unsigned long long h = 1469598103934665603ULL;
+    auto mix = [&](long long v){
+        unsigned long long u = static_cast<unsigned long long>(v);
+        for (int b = 0; b < 8; ++b){
+            h ^= (u >> (8 * b)) & 0xff;
+            h *= 1099511628211ULL;
+        }
+    };
+    int n = data.size;
+    mix(n);
+    data.visit([&](const auto &D){
+        for (int i = 0; i < n; ++i)
+            {for (int j = 0; j < n; ++j) if (i != j) mix(static_cast<long long>(D(i, j)));}
+    });
+    return h;
+}
+
+long long tourCost(const ATSPDataC &data, const vector<int> &tour){
+    int n = data.size;
+    if (static_cast<int>(tour.size()) != n)
+        {return -1;}
+    vector<char> seen(n, 0);
+    long long cost = 0;
+    for (int t = 0; t < n; ++t){
+        int v = tour[t];
+        if (v < 0 || v >= n || seen[v])
+            {return -1;}
+        seen[v] = 1;
+        cost += data.dist(v, tour[(t + 1) % n]);
+    }
+    return cost;
+}
+
+bool writeCheckpoint(const string &path, const Checkpoint &c){
+    string tmp = path + ".tmp";
+    {
+        ofstream out(tmp);
+        if (!out)
+            {return false;}
+        out << MAGIC << " " << VERSION << "\n";
+        string name = c.instance.empty() ? "NA" : c.instance;
+        replace(name.begin(), name.end(), ' ', '_'); // 1 mot (NAME libre en TSPLIB)
+        out << "instance " << name << " " << c.n << " " << hex << c.fingerprint << dec << "\n";
+        out << "mode " << (c.mode.empty() ? "NA" : c.mode) << "\n";
+        out << setprecision(17) << "elapsed " << c.elapsed << "\n";
+        if (c.hasBound)
+            {out << "bound " << c.bound << "\n";}
+        else
+            {out << "bound NA\n";}
+        if (c.tourCost >= 0){
+            out << "tour " << c.tourCost;
+            for (int v : c.tour)
+                {out << " " << v;}
+            out << "\n";
+        }
+        else
+            {out << "tour NA\n";}
+
+        out << "subtours " << c.subtours.size() << "\n";
+        for (const vector<int> &S : c.subtours){
+            out << S.size();
+            for (int v : S)
+                {out << " " << v;}
+            out << "\n";
+        }
+        out << "lifted " << c.lifted.size() << "\n";
+        for (const LiftedCycle &cut : c.lifted){
+            out << (cut.plus ? '+' : '-') << " " << cut.seq.size();
+            for (int v : cut.seq)
+                {out << " " << v;}
+            out << "\n";
+        }
+        out << "END\n";
+        if (!out.flush())
+            {return false;}
+    }
+#ifdef _WIN32
+    remove(path.c_str()); // rename ne remplace pas sous Windows
+#endif
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+// ligne suivante du fichier => fields ; false en fin de fichier
+static bool nextLine(ifstream &in, istringstream &fields){
+    string line;
+    if (!getline(in, line))
+        {return false;}
+    fields.clear();
+    fields.str(line);
+    return true;
+}
+
+// "cle valeur..." : la ligne suivante doit commencer par key
+static bool expectKey(ifstream &in, const string &key, istringstream &fields){
+    string k;
+    return nextLine(in, fields) && (fields >> k) && k == key;
+}
+
+// count sommets distincts de [0, n) ; count <= n verifie avant toute allocation
+static bool readNodes(istringstream &fields, int n, size_t count, vector<int> &nodes){
+    if (count > static_cast<size_t>(n))
+        {return false;}
+    nodes.resize(count);
+    for (size_t t = 0; t < count; ++t){
+        if (!(fields >> nodes[t]) || nodes[t] < 0 || nodes[t] >= n)
+            {return false;}
+    }
+    vector<int> sorted(nodes);
+    sort(sorted.begin(), sorted.end());
+    return adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+}
+
+bool readCheckpoint(const string &path, Checkpoint &c){
+    ifstream in(path);
+    if (!in)
+        {return false;}
+    c = Checkpoint();
+    istringstream fields;
+    string word;
+    int version = 0;
+    if (!expectKey(in, MAGIC, fields) || !(fields >> version) || version != VERSION)
+        {return false;}
+    if (!expectKey(in, "instance", fields) || !(fields >> c.instance >> c.n >> hex >> c.fingerprint >> dec) || c.n <= 0)
+        {return false;}
+    if (!expectKey(in, "mode", fields) || !(fields >> c.mode))
+        {return false;}
+    if (!expectKey(in, "elapsed", fields) || !(fields >> c.elapsed))
+        {return false;}
+
+    if (!expectKey(in, "bound", fields) || !(fields >> word))
+        {return false;}
+    if (word != "NA"){
+        c.hasBound = true;
+        c.bound = atof(word.c_str());
+    }
+
+    if (!expectKey(in, "tour", fields) || !(fields >> word))
+        {return false;}
+    if (word != "NA"){
+        c.tourCost = atoll(word.c_str());
+        if (!readNodes(fields, c.n, static_cast<size_t>(c.n), c.tour))
+            {return false;}
+    }
+
+    // compteurs non fiables : 1 coupe ajoutee par ligne lue (pas de resize(count) sur un fichier corrompu)
+    size_t count = 0;
+    if (!expectKey(in, "subtours", fields) || !(fields >> count))
+        {return false;}
+    for (size_t t = 0; t < count; ++t){
+        size_t size = 0;
+        if (!nextLine(in, fields) || !(fields >> size) || size == 0 || size >= static_cast<size_t>(c.n))
+            {return false;}
+        c.subtours.emplace_back();
+        if (!readNodes(fields, c.n, size, c.subtours.back()))
+            {return false;}
+    }
+
+    if (!expectKey(in, "lifted", fields) || !(fields >> count))
+        {return false;}
+    for (size_t t = 0; t < count; ++t){
+        string sign;
+        size_t size = 0;
+        if (!nextLine(in, fields) || !(fields >> sign >> size) || (sign != "+" && sign != "-") || size < 3)
+            {return false;}
+        c.lifted.emplace_back();
+        LiftedCycle &cut = c.lifted.back();
+        if (!readNodes(fields, c.n, size, cut.seq))
+            {return false;}
+        cut.plus = (sign == "+");
+        cut.violation = 0.0;
+    }
+
+    return expectKey(in, "END", fields); // fichier complet
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "ATSP_Data.hpp"
+#include "ATSP_Sep.hpp"
+
+using namespace std;
+
+// ======================================================================
+// ============== POINT DE REPRISE (--checkpoint / --resume) ============
+// ======================================================================
+// longues resolutions coupees en tranches : meilleur tour, meilleure borne et coupes generees (ensembles de
+// sommets, valides quels que soient les couts) ecrits regulierement ; la tranche suivante reconstruit le modele
+// avec ces coupes et le tour en MIP start
+// fichier texte ligne par ligne (1 coupe == 1 ligne), ecrit dans FILE.tmp puis renomme (jamais a moitie ecrit)
+
+struct Checkpoint{
+    string instance;                // NAME
+    int n = 0;
+    unsigned long long fingerprint = 0; // couts (instanceFingerprint) : reprise sur une autre instance refusee
+    string mode;                    // mode de la tranche qui a ecrit (information)
+    double elapsed = 0.0;           // secondes cumulees sur toutes les tranches
+
+    bool hasBound = false;
+    double bound = 0.0;             // meilleure borne inf prouvee
+    long long tourCost = -1;        // cout de tour (-1 == pas de tour)
+    vector<int> tour;               // meilleur tour depuis 0
+
+    vector<vector<int>> subtours;   // S : x(delta-(S)) >= 1
+    vector<LiftedCycle> lifted;     // D_k+/-
+
+    // garde la meilleure borne / le meilleur tour
+    void offerBound(double b){
+        if (!hasBound || b > bound){
+            bound = b;
+            hasBound = true;
+        }
+    }
+    void offerTour(const vector<int> &t, long long cost){
+        if (tourCost < 0 || cost < tourCost){
+            tour = t;
+            tourCost = cost;
+        }
+    }
+};
+
+// empreinte des couts (FNV-1a 64 sur n et la matrice)
+unsigned long long instanceFingerprint(const ATSPDataC &data);
+
+// cout du tour (vide si ce n'est pas une permutation de 0..n-1)
+long long tourCost(const ATSPDataC &data, const vector<int> &tour);
+
+bool writeCheckpoint(const string &path, const Checkpoint &c);
+
+// false si illisible, tronque ou incoherent (sommets hors de [0, n) ou repetes, tour non permutation, D_k avec k < 3)
+bool readCheckpoint(const string &path, Checkpoint &c);
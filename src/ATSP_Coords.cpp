@@ -0,0 +1,188 @@
+#include "ATSP_Coords.hpp"
+#include "ATSP_Simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+static const double GEO_RRR = 6378.388;
+
+CoordMetric coordMetric(const string &t){
+    if (t == "EUC_2D")
+        {return CoordMetric::Euc2D;}
+    if (t == "CEIL_2D")
+        {return CoordMetric::Ceil2D;}
+    if (t == "ATT")
+        {return CoordMetric::Att;}
+    if (t == "GEO")
+        {return CoordMetric::Geo;}
+    if (t == "MAN_2D")
+        {return CoordMetric::Man2D;}
+    if (t == "MAX_2D")
+        {return CoordMetric::Max2D;}
+    return CoordMetric::None;
+}
+
+DistanceKernel activeDistanceKernel(){
+    return cpuHasAvx2() ? DistanceKernel::Avx2 : DistanceKernel::Scalar;
+}
+
+const char *distanceKernelName(DistanceKernel k){
+    return k == DistanceKernel::Avx2 ? "avx2" : "scalar";
+}
+
+void NodeCoords::clear(){
+    metric = CoordMetric::None;
+    for (vector<double> *v : {&x, &y, &cosLat, &sinLat, &cosLon, &sinLon}){
+        v->clear();
+        v->shrink_to_fit();
+    }
+}
+
+// latitude / longitude GEO en radians (partie entiere == degres, decimales == minutes)
+static double geoRadians(double v){
+    const double PI = 3.141592;
+    double deg = static_cast<double>(static_cast<int>(v));
+    double min = v - deg;
+    return PI * (deg + 5.0 * min / 3.0) / 180.0;
+}
+
+void NodeCoords::prepare(){
+    if (metric != CoordMetric::Geo)
+        {return;}
+    int n = size();
+    cosLat.resize(n);
+    sinLat.resize(n);
+    cosLon.resize(n);
+    sinLon.resize(n);
+    for (int i = 0; i < n; ++i){
+        double lat = geoRadians(x[i]), lon = geoRadians(y[i]);
+        cosLat[i] = cos(lat);
+        sinLat[i] = sin(lat);
+        cosLon[i] = cos(lon);
+        sinLon[i] = sin(lon);
+    }
+}
+
+static int nint(double v) { return static_cast<int>(v + 0.5); }
+
+// fonctions de distance TSPLIB95
+int coordDistance(const NodeCoords &c, int i, int j){
+    double dx = c.x[i] - c.x[j];
+    double dy = c.y[i] - c.y[j];
+
+    switch (c.metric){
+    case CoordMetric::Euc2D:
+        return nint(sqrt(dx * dx + dy * dy));
+    case CoordMetric::Ceil2D:
+        return static_cast<int>(ceil(sqrt(dx * dx + dy * dy)));
+    case CoordMetric::Att:{
+        double r = sqrt((dx * dx + dy * dy) / 10.0);
+        int tij = nint(r);
+        return (tij < r) ? tij + 1 : tij;
+    }
+    case CoordMetric::Man2D:
+        return nint(fabs(dx) + fabs(dy));
+    case CoordMetric::Max2D:
+        return max(nint(fabs(dx)), nint(fabs(dy)));
+    default:
+        break;
+    }
+
+    // GEO : 0.5 * ((1 + q1) * q2 - (1 - q1) * q3) == cos(latI) cos(latJ) cos(lonI - lonJ) + sin(latI) sin(latJ)
+    // borne a 1 : sommets confondus (ali535) => arrondi au dessus de 1, acos == NaN
+    double q1 = c.cosLon[i] * c.cosLon[j] + c.sinLon[i] * c.sinLon[j];
+    double cc = c.cosLat[i] * c.cosLat[j] * q1 + c.sinLat[i] * c.sinLat[j];
+    return static_cast<int>(GEO_RRR * acos(min(cc, 1.0)) + 1.0);
+}
+
+static void distanceRowScalar(const NodeCoords &c, int i, const int *cand, int j0, int m, int32_t *out){
+    for (int k = 0; k < m; ++k)
+        {out[k] = coordDistance(c, i, cand ? cand[k] : j0 + k);}
+}
+
+#ifdef ATSP_X86_SIMD
+// 4 valeurs base[j] : gather si cand, chargement contigu sinon
+__attribute__((target("avx2"))) static inline __m256d load4(const double *base, const int *cand, int j0, int k){
+    if (cand)
+        {return _mm256_i32gather_pd(base, _mm_loadu_si128(reinterpret_cast<const __m128i *>(cand + k)), 8);}
+    return _mm256_loadu_pd(base + j0 + k);
+}
+
+// memes operations, meme ordre que coordDistance (pas de FMA : cible avx2 seule) => resultats identiques
+__attribute__((target("avx2"))) static void distanceRowAvx2(const NodeCoords &c, int i, const int *cand, int j0, int m,
+                                                            int32_t *out){
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    const CoordMetric metric = c.metric;
+
+    int k = 0;
+    for (; k + 4 <= m; k += 4){
+        __m256d d;
+        if (metric == CoordMetric::Geo){
+            __m256d q1 = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(c.cosLon[i]), load4(c.cosLon.data(), cand, j0, k)),
+                                       _mm256_mul_pd(_mm256_set1_pd(c.sinLon[i]), load4(c.sinLon.data(), cand, j0, k)));
+            __m256d cc = _mm256_add_pd(
+                _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(c.cosLat[i]), load4(c.cosLat.data(), cand, j0, k)), q1),
+                _mm256_mul_pd(_mm256_set1_pd(c.sinLat[i]), load4(c.sinLat.data(), cand, j0, k)));
+            alignas(32) double v[4];
+            _mm256_store_pd(v, _mm256_min_pd(cc, one));
+            for (int l = 0; l < 4; ++l) // pas d'acos vectoriel
+                {out[k + l] = static_cast<int32_t>(GEO_RRR * acos(v[l]) + 1.0);}
+            continue;
+        }
+
+        __m256d dx = _mm256_sub_pd(_mm256_set1_pd(c.x[i]), load4(c.x.data(), cand, j0, k));
+        __m256d dy = _mm256_sub_pd(_mm256_set1_pd(c.y[i]), load4(c.y.data(), cand, j0, k));
+        __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+
+        switch (metric){
+        case CoordMetric::Euc2D:
+            d = _mm256_add_pd(_mm256_sqrt_pd(d2), half);
+            break;
+        case CoordMetric::Ceil2D:
+            d = _mm256_ceil_pd(_mm256_sqrt_pd(d2));
+            break;
+        case CoordMetric::Att:{
+            __m256d r = _mm256_sqrt_pd(_mm256_div_pd(d2, _mm256_set1_pd(10.0)));
+            __m256d t = _mm256_round_pd(_mm256_add_pd(r, half), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+            d = _mm256_add_pd(t, _mm256_and_pd(_mm256_cmp_pd(t, r, _CMP_LT_OQ), one));
+            break;
+        }
+        case CoordMetric::Man2D:
+            d = _mm256_add_pd(_mm256_add_pd(_mm256_and_pd(dx, absMask), _mm256_and_pd(dy, absMask)), half);
+            break;
+        default: // Max2D
+            d = _mm256_max_pd(
+                _mm256_round_pd(_mm256_add_pd(_mm256_and_pd(dx, absMask), half), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC),
+                _mm256_round_pd(_mm256_add_pd(_mm256_and_pd(dy, absMask), half), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+            break;
+        }
+        // troncature == static_cast<int>
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + k), _mm256_cvttpd_epi32(d));
+    }
+
+    distanceRowScalar(c, i, cand ? cand + k : nullptr, j0 + k, m - k, out + k);
+}
+#endif
+
+static void dispatchRow(const NodeCoords &c, int i, const int *cand, int j0, int m, int32_t *out, DistanceKernel kernel){
+#ifdef ATSP_X86_SIMD
+    if (kernel == DistanceKernel::Avx2 && activeDistanceKernel() == DistanceKernel::Avx2){
+        distanceRowAvx2(c, i, cand, j0, m, out);
+        return;
+    }
+#endif
+    (void)kernel;
+    distanceRowScalar(c, i, cand, j0, m, out);
+}
+
+void distanceRow(const NodeCoords &c, int i, const int *cand, int m, int32_t *out, DistanceKernel kernel){
+    dispatchRow(c, i, cand, 0, m, out, kernel);
+}
+
+void distanceRange(const NodeCoords &c, int i, int j0, int j1, int32_t *out, DistanceKernel kernel){
+    if (j1 > j0)
+        {dispatchRow(c, i, nullptr, j0, j1 - j0, out, kernel);}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ======================================================================
+// ============== COORDONNEES (SoA) + NOYAUX DE DISTANCE ================
+// ======================================================================
+// distances TSPLIB95 d'1 sommet vers m candidats en 1 appel (voisins, pricing)
+// AVX2 (4 candidats / iteration) si le CPU le supporte, scalaire sinon : resultats identiques
+
+enum class CoordMetric{None, Euc2D, Ceil2D, Att, Geo, Man2D, Max2D};
+
+// EDGE_WEIGHT_TYPE => metrique (None si non supporte)
+CoordMetric coordMetric(const string &edgeWeightType);
+
+enum class DistanceKernel{Scalar, Avx2};
+
+// noyau choisi a l'execution (Avx2 si compile pour x86 et supporte par le CPU)
+DistanceKernel activeDistanceKernel();
+const char *distanceKernelName(DistanceKernel k);
+
+// NODE_COORD_SECTION en structure de tableaux (x[], y[] contigus => chargement vectoriel)
+struct NodeCoords{
+    CoordMetric metric = CoordMetric::None;
+    vector<double> x;
+    vector<double> y;
+
+    // GEO : precalcule par sommet (prepare) => plus de cos() par couple
+    vector<double> cosLat, sinLat, cosLon, sinLon;
+
+    int size() const { return static_cast<int>(x.size()); }
+    bool empty() const { return x.empty(); }
+
+    void assign(int n, CoordMetric m){
+        metric = m;
+        x.assign(n, 0.0);
+        y.assign(n, 0.0);
+    }
+    void clear();
+
+    // a appeler une fois les coordonnees lues (GEO : trigo par sommet)
+    void prepare();
+};
+
+// d(i,j) TSPLIB95 (reference scalaire)
+int coordDistance(const NodeCoords &c, int i, int j);
+
+// out[k] = d(i, cand[k]) pour k < m
+void distanceRow(const NodeCoords &c, int i, const int *cand, int m, int32_t *out,
+                 DistanceKernel kernel = activeDistanceKernel());
+
+// out[j - j0] = d(i, j) pour j0 <= j < j1 (candidats contigus, sans gather)
+void distanceRange(const NodeCoords &c, int i, int j0, int j1, int32_t *out,
+                   DistanceKernel kernel = activeDistanceKernel());
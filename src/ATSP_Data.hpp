@@ -1,49 +1,397 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <vector>
 #include <string>
+#include "ATSP_Coords.hpp"
+#include "ATSP_Parse.hpp"
 
 using namespace std;
 
+// type des poids choisi au chargement : le plus etroit qui contient toutes les valeurs hors diagonale
+enum class WeightType{
+  UInt16, // 0 <= d <= 65535 (br17, ftv*, la plupart des TSPLIB) => matrice 2x plus petite
+  Int32,
+  Int64
+};
+
+// ce que lit le constructeur
+enum class LoadMode{
+  Full,   // entete + distances
+  Header, // entete seulement (size, type, ...) sans allouer les distances (pre-vol memoire)
+  Coords  // entete + NODE_COORD_SECTION sans matrice (index spatial des tres grandes instances)
+};
+
+// nouveau cout d'un arc (reoptimisation : ATSP_CUT / ATSP_MTZ::reoptimize)
+struct ArcCost{
+  int i;
+  int j;
+  long long cost;
+};
+
+// matrice n x n a plat (ligne par ligne), diagonale == 0 (sentinelles TSPLIB ignorees)
+template <typename W>
+struct DistanceMatrix{
+  int n = 0;
+  vector<W> w;
+
+  void assign(int size) { n = size; w.assign(static_cast<size_t>(size) * size, W(0)); }
+  void clear() { n = 0; w.clear(); w.shrink_to_fit(); }
+  W operator()(int i, int j) const { return w[static_cast<size_t>(i) * n + j]; }
+  W &at(int i, int j) { return w[static_cast<size_t>(i) * n + j]; }
+  const W *row(int i) const { return w.data() + static_cast<size_t>(i) * n; }
+};
+
 class ATSPDataC{
 public:
   int size;
-  vector<vector<int>> distances;
+  WeightType weightType;
+
+  string name;             // NAME
+  string type;             // TYPE (ATSP | TSP)
+  string edgeWeightType;   // EXPLICIT | EUC_2D | CEIL_2D | ATT | GEO | ...
+  string edgeWeightFormat; // FULL_MATRIX | LOWER_DIAG_ROW | ... (si EXPLICIT)
+  bool symmetric;          // c_ij == c_ji pour tout i != j
+  NodeCoords coords;       // vide si EXPLICIT
+
+  DistanceMatrix<uint16_t> d16; // une seule des trois est remplie (weightType)
+  DistanceMatrix<int32_t> d32;
+  DistanceMatrix<int64_t> d64;
 
-  ATSPDataC(string filename){
+  // LoadMode::Coords sur une instance EXPLICIT == LoadMode::Header (coords vide)
+  ATSPDataC(string filename, LoadMode mode = LoadMode::Full) : size(-1), weightType(WeightType::Int32), symmetric(false){
     ifstream inf(filename);
     if (!inf){
       size = -1;
       return;
     }
 
-    string temp;
-    do{
-      inf >> temp >> ws;
-      if (temp == "DIMENSION:")
-        inf >> size >> ws;
-    } while (temp != "EDGE_WEIGHT_SECTION");
-    distances.resize(size, vector<int>(size));
-    for (size_t i = 0; i < size; ++i){
-      for (size_t j = 0; j < size; ++j){
-        inf >> distances[i][j] >> ws;
+    // entete TSPLIB : "CLE: valeur" ou "CLE : valeur", puis 1 section
+    string line, section;
+    while (getline(inf, line)){
+      size_t colon = line.find(':');
+      string key = trim(line.substr(0, colon));
+      string value = (colon == string::npos) ? "" : trim(line.substr(colon + 1));
+
+      if (key == "NAME")
+        name = value;
+      else if (key == "TYPE")
+        type = firstWord(value); // "TSP (M.~Hofmeister)" => TSP
+      else if (key == "DIMENSION")
+        size = atoi(value.c_str());
+      else if (key == "EDGE_WEIGHT_TYPE")
+        edgeWeightType = firstWord(value);
+      else if (key == "EDGE_WEIGHT_FORMAT")
+        edgeWeightFormat = firstWord(value);
+      else if (key == "EDGE_WEIGHT_SECTION" || key == "NODE_COORD_SECTION"){
+        section = key;
+        break;
       }
+      else if (key == "EOF")
+        break;
+    }
+
+    if (size <= 0 || section.empty()){
+      size = -1; // fichier non reconnu
+      return;
+    }
+
+    if (mode != LoadMode::Full){
+      symmetric = (type == "TSP"); // matrice non lue
+      if (mode == LoadMode::Coords && section == "NODE_COORD_SECTION" && !readNodeCoords(inf))
+        size = -1;
+      return;
     }
+
+    // lecture en int32, promu en int64 si besoin, puis reduit en uint16 si possible
+    weightType = WeightType::Int32;
+    d32.assign(size);
+    bool ok = (section == "EDGE_WEIGHT_SECTION") ? readExplicit(inf) : readCoords(inf);
     inf.close();
+
+    if (!ok){
+      size = -1;
+      d32.clear();
+      d64.clear();
+      return;
+    }
+    narrow();
+
+    // symetrique si TYPE: TSP ou si la matrice l'est (diagonale ignoree)
+    symmetric = (type == "TSP") || isSymmetricMatrix();
+  }
+
+  // matrice en memoire (n x n ligne par ligne, diagonale ignoree) : requetes --serve sans fichier
+  ATSPDataC(const string &name, int n, const vector<long long> &weights)
+      : size(n), weightType(WeightType::Int32), name(name), type("ATSP"), edgeWeightType("EXPLICIT"),
+        edgeWeightFormat("FULL_MATRIX"), symmetric(false){
+    if (n <= 0 || weights.size() != static_cast<size_t>(n) * n){
+      size = -1;
+      return;
+    }
+    d32.assign(size);
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j)
+        setWeight(i, j, weights[static_cast<size_t>(i) * n + j]);
+    narrow();
+    symmetric = isSymmetricMatrix();
+  }
+
+  // acces generique (construction des modeles) ; noyaux chauds => visit()
+  long long dist(int i, int j) const{
+    switch (weightType){
+    case WeightType::UInt16:
+      return d16(i, j);
+    case WeightType::Int32:
+      return d32(i, j);
+    default:
+      return d64(i, j);
+    }
+  }
+
+  // appelle f(matrice typee) => 1 instanciation du noyau par type de poids
+  template <typename F>
+  auto visit(F &&f) const -> decltype(f(d32)){
+    switch (weightType){
+    case WeightType::UInt16:
+      return f(d16);
+    case WeightType::Int32:
+      return f(d32);
+    default:
+      return f(d64);
+    }
+  }
+
+  static int weightBytes(WeightType t) { return t == WeightType::UInt16 ? 2 : (t == WeightType::Int32 ? 4 : 8); }
+  static const char *weightName(WeightType t) { return t == WeightType::UInt16 ? "u16" : (t == WeightType::Int32 ? "i32" : "i64"); }
+
+  // cout mis a jour (reoptimisation) : type de poids elargi si v n'y tient pas (jamais reduit) ;
+  // symmetric n'est pas recalcule (modeles orientes seulement)
+  void updateWeight(int i, int j, long long v){
+    if (i == j || i < 0 || j < 0 || i >= size || j >= size)
+      return;
+    setWeight(i, j, v);
   }
 
   void printData(){
     cout << "==================================" << endl;
-    cout << "Size : " << size << endl;
+    cout << "Size : " << size << " (" << weightName(weightType) << ")" << endl;
     cout << "Distances :" << endl;
-    for (size_t i = 0; i < size; ++i){
-      for (size_t j = 0; j < size; ++j){
-        cout << distances[i][j] << " ";
+    for (int i = 0; i < size; ++i){
+      for (int j = 0; j < size; ++j){
+        cout << dist(i, j) << " ";
       }
       cout << endl;
     }
     cout << "==================================" << endl;
   }
+
+private:
+  // ecrit d(i,j) (diagonale ignoree : ftv* y met 100000000 comme sentinelle) ;
+  // v hors du type courant => u16 -> i32 -> i64
+  void setWeight(int i, int j, long long v){
+    if (i == j)
+      return;
+    if (weightType == WeightType::UInt16){
+      if (v >= 0 && v <= UINT16_MAX){
+        d16.at(i, j) = static_cast<uint16_t>(v);
+        return;
+      }
+      d32.assign(size);
+      for (size_t k = 0; k < d16.w.size(); ++k)
+        d32.w[k] = d16.w[k];
+      d16.clear();
+      weightType = WeightType::Int32;
+    }
+    if (weightType == WeightType::Int32 && (v < INT32_MIN || v > INT32_MAX)){
+      d64.assign(size);
+      for (size_t k = 0; k < d32.w.size(); ++k)
+        d64.w[k] = d32.w[k];
+      d32.clear();
+      weightType = WeightType::Int64;
+    }
+    if (weightType == WeightType::Int64)
+      d64.at(i, j) = v;
+    else
+      d32.at(i, j) = static_cast<int32_t>(v);
+  }
+
+  // int32 => uint16 si toutes les valeurs hors diagonale sont dans [0, 65535]
+  void narrow(){
+    if (weightType != WeightType::Int32)
+      return;
+    for (int32_t v : d32.w)
+      if (v < 0 || v > UINT16_MAX)
+        return;
+    d16.assign(size);
+    for (size_t k = 0; k < d32.w.size(); ++k)
+      d16.w[k] = static_cast<uint16_t>(d32.w[k]);
+    d32.clear();
+    weightType = WeightType::UInt16;
+  }
+
+  static string trim(const string &s){
+    size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == string::npos)
+      return "";
+    size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+  }
+
+  static string firstWord(const string &s){
+    istringstream iss(s);
+    string w;
+    iss >> w;
+    return w;
+  }
+
+  // disposition de EDGE_WEIGHT_SECTION : ligne i == colonnes [rowBegin, rowEnd)
+  // *_COL == transposee de *_ROW (meme ordre pour une matrice symetrique)
+  struct ExplicitLayout{
+    int n;
+    bool full, upper, diag;
+
+    int rowBegin(int i) const { return full ? 0 : (upper ? (diag ? i : i + 1) : 0); }
+    int rowEnd(int i) const { return full ? n : (upper ? n : (diag ? i + 1 : i)); }
+  };
+
+  // EDGE_WEIGHT_SECTION : matrice pleine ou triangulaire (symetrisee)
+  // section en memoire, decoupee en blocs lus en parallele, chaque bloc ecrit directement dans la matrice
+  bool readExplicit(ifstream &inf){
+    const string &f = edgeWeightFormat;
+    ExplicitLayout L;
+    L.n = size;
+    L.full = f.empty() || f == "FULL_MATRIX";
+    L.upper = (f == "UPPER_ROW" || f == "UPPER_DIAG_ROW" || f == "LOWER_COL" || f == "LOWER_DIAG_COL");
+    bool lower = (f == "LOWER_ROW" || f == "LOWER_DIAG_ROW" || f == "UPPER_COL" || f == "UPPER_DIAG_COL");
+    L.diag = (f.find("DIAG") != string::npos);
+    if (!L.full && !L.upper && !lower){
+      cerr << "EDGE_WEIGHT_FORMAT non supporte : " << f << endl;
+      return false;
+    }
+
+    // rowStart[i] == rang du 1er nombre de la ligne i dans la section
+    vector<long long> rowStart(size + 1, 0);
+    for (int i = 0; i < size; ++i)
+      rowStart[i + 1] = rowStart[i] + (L.rowEnd(i) - L.rowBegin(i));
+
+    vector<char> buf = readRemaining(inf);
+    long long total = 0;
+    vector<TokenChunk> chunks = splitTokenChunks(buf.data(), buf.data() + buf.size(), parseThreads(buf.size()), total);
+    if (total < rowStart[size])
+      return false;
+
+    int status = fillExplicit(d32, L, chunks, rowStart);
+    if (status == 1){
+      // valeur hors int32 : relecture en int64
+      d32.clear();
+      d64.assign(size);
+      weightType = WeightType::Int64;
+      status = fillExplicit(d64, L, chunks, rowStart);
+    }
+    return status == 0;
+  }
+
+  // 0 == ok, 1 == valeur hors de W (hors diagonale), 2 == nombre illisible
+  template <typename W>
+  static int fillExplicit(DistanceMatrix<W> &D, const ExplicitLayout &L, const vector<TokenChunk> &chunks,
+                          const vector<long long> &rowStart){
+    long long count = rowStart[L.n];
+    vector<int> status(chunks.size(), 0);
+
+    forEachChunk(chunks, [&](size_t k, const TokenChunk &c){
+      if (c.first >= count)
+        return; // apres la section (EOF, DISPLAY_DATA_SECTION ...)
+
+      // ligne non vide qui contient le nombre de rang c.first
+      int i = static_cast<int>(upper_bound(rowStart.begin(), rowStart.end(), c.first) - rowStart.begin()) - 1;
+      int j = L.rowBegin(i) + static_cast<int>(c.first - rowStart[i]);
+      const char *p = c.begin;
+
+      for (long long t = c.first; t < count; ++t){
+        long long v;
+        if (!parseInteger(p, c.end, v)){
+          if (p != c.end)
+            status[k] = 2;
+          return;
+        }
+        // diagonale ignoree (ftv* : sentinelle 100000000)
+        if (i != j){
+          if (v < numeric_limits<W>::min() || v > numeric_limits<W>::max()){
+            status[k] = 1;
+            return;
+          }
+          D.at(i, j) = static_cast<W>(v);
+          if (!L.full)
+            D.at(j, i) = static_cast<W>(v);
+        }
+        if (++j == L.rowEnd(i)){
+          do
+            ++i;
+          while (i < L.n && L.rowBegin(i) == L.rowEnd(i));
+          j = (i < L.n) ? L.rowBegin(i) : 0;
+        }
+      }
+    });
+
+    int worst = 0;
+    for (int st : status)
+      worst = max(worst, st);
+    return worst;
+  }
+
+  // NODE_COORD_SECTION : "id x y"
+  bool readNodeCoords(ifstream &inf){
+    CoordMetric metric = coordMetric(edgeWeightType);
+    if (metric == CoordMetric::None){
+      cerr << "EDGE_WEIGHT_TYPE non supporte : " << edgeWeightType << endl;
+      return false;
+    }
+
+    coords.assign(size, metric);
+    for (int k = 0; k < size; ++k){
+      int id;
+      double x, y;
+      if (!(inf >> id >> x >> y) || id < 1 || id > size){
+        coords.clear();
+        return false;
+      }
+      coords.x[id - 1] = x;
+      coords.y[id - 1] = y;
+    }
+    coords.prepare();
+    return true;
+  }
+
+  // coordonnees puis distances TSPLIB (1 ligne par appel du noyau distanceRange)
+  bool readCoords(ifstream &inf){
+    if (!readNodeCoords(inf))
+      return false;
+
+    vector<int32_t> row(size);
+    for (int i = 0; i < size; ++i){
+      distanceRange(coords, i, i + 1, size, row.data());
+      for (int j = i + 1; j < size; ++j){
+        setWeight(i, j, row[j - i - 1]);
+        setWeight(j, i, row[j - i - 1]);
+      }
+    }
+    return true;
+  }
+
+  bool isSymmetricMatrix() const{
+    return visit([&](const auto &D){
+      for (int i = 0; i < size; ++i)
+        for (int j = i + 1; j < size; ++j)
+          if (D(i, j) != D(j, i))
+            return false;
+      return true;
+    });
+  }
 };
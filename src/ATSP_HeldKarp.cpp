@@ -0,0 +1,196 @@
+#include "ATSP_HeldKarp.hpp"
+#include "ATSP_Simd.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+using namespace std;
+
+ATSP_HeldKarp::ATSP_HeldKarp(ATSPDataC data) : data(data), cost(0), solved(false) {}
+
+// min(best, min_i a[i] + b[i])
+template <typename T>
+static T minPlusScalar(const T *a, const T *b, int m, T best){
+    for (int i = 0; i < m; ++i)
+        {best = min(best, static_cast<T>(a[i] + b[i]));}
+    return best;
+}
+
+#ifdef ATSP_X86_SIMD
+__attribute__((target("avx2"))) static int32_t minPlusAvx2(const int32_t *a, const int32_t *b, int m, int32_t best){
+    __m256i acc = _mm256_set1_epi32(best);
+    int i = 0;
+    for (; i + 8 <= m; i += 8){
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        acc = _mm256_min_epi32(acc, _mm256_add_epi32(va, vb));
+    }
+    alignas(32) int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    for (int l = 0; l < 8; ++l)
+        {best = min(best, lanes[l]);}
+    return minPlusScalar(a + i, b + i, m - i, best);
+}
+#endif
+
+static int32_t minPlus(const int32_t *a, const int32_t *b, int m, int32_t best){
+#ifdef ATSP_X86_SIMD
+    if (cpuHasAvx2())
+        {return minPlusAvx2(a, b, m, best);}
+#endif
+    return minPlusScalar(a, b, m, best);
+}
+
+static int64_t minPlus(const int64_t *a, const int64_t *b, int m, int64_t best){
+    return minPlusScalar(a, b, m, best); // pas de min epi64 en AVX2
+}
+
+void ATSP_HeldKarp::solve(){
+    stats.resetForSolve(); // garde lecture / estimation mesurees par l'appelant
+    solved = false;
+    tour.clear();
+    cost = 0;
+
+    int n = data.size;
+    if (n < 1 || n > MAX_N){
+        cerr << "Held-Karp : n == " << n << " hors de [1, " << MAX_N << "]" << endl;
+        return;
+    }
+
+    long long start = nowNs();
+    if (n <= 2){
+        for (int i = 0; i < n; ++i)
+            {tour.push_back(i);}
+        cost = (n == 2) ? data.dist(0, 1) + data.dist(1, 0) : 0;
+        solved = true;
+    }
+    else{
+        // int32 (AVX2, 2x moins de memoire) si tout chemin tient : couts >= 0 et n * max < 2^29
+        long long lo = 0, hi = 0;
+        for (int i = 0; i < n; ++i){
+            for (int j = 0; j < n; ++j){
+                if (i != j){
+                    lo = min(lo, data.dist(i, j));
+                    hi = max(hi, data.dist(i, j));
+                }
+            }
+        }
+        if (lo >= 0 && hi * n < (1LL << 29))
+            {run<int32_t>(1 << 30);}
+        else
+            {run<int64_t>(1LL << 60);}
+    }
+    stats.optimizeNs = nowNs() - start;
+    stats.addTrajectory(nsToSec(stats.optimizeNs), static_cast<double>(cost), static_cast<double>(cost));
+}
+
+template <typename T>
+void ATSP_HeldKarp::run(T inf){
+    int n = data.size;
+    int m = n - 1; // sommets 1..n-1 <=> bits 0..m-1
+    size_t subsets = size_t(1) << m;
+    size_t full = subsets - 1;
+
+    // couts transposes : ct[j * m + i] == d(i+1, j+1) => boucle min contigue sur i
+    vector<T> ct(size_t(m) * m, T(0));
+    for (int i = 0; i < m; ++i)
+        {for (int j = 0; j < m; ++j)
+            {if (i != j) ct[size_t(j) * m + i] = static_cast<T>(data.dist(i + 1, j + 1));}}
+
+    // dp[S * m + j] ; j hors de S == inf => pas de masque dans la boucle min
+    vector<T> dp(subsets * m, inf);
+    for (int j = 0; j < m; ++j)
+        {dp[(size_t(1) << j) * m + j] = static_cast<T>(data.dist(0, j + 1));}
+
+    // sous ensembles ranges par taille (tri par comptage) : 1 couche == 1 taille, independants entre eux
+    vector<uint8_t> pc(subsets, 0);
+    vector<size_t> layerStart(m + 2, 0);
+    for (size_t S = 0; S < subsets; ++S){
+        pc[S] = static_cast<uint8_t>(pc[S >> 1] + (S & 1));
+        layerStart[pc[S] + 1]++;
+    }
+    for (int k = 1; k <= m + 1; ++k)
+        {layerStart[k] += layerStart[k - 1];}
+    vector<uint32_t> order(subsets);
+    {
+        vector<size_t> fill(layerStart.begin(), layerStart.end() - 1);
+        for (size_t S = 0; S < subsets; ++S)
+            {order[fill[pc[S]]++] = static_cast<uint32_t>(S);}
+    }
+    pc.clear();
+    pc.shrink_to_fit();
+
+    auto relax = [&](size_t lo, size_t hi){
+        for (size_t t = lo; t < hi; ++t){
+            size_t S = order[t];
+            T *row = dp.data() + S * m;
+            for (int j = 0; j < m; ++j){
+                if (S & (size_t(1) << j)){
+                    size_t prev = S ^ (size_t(1) << j);
+                    row[j] = minPlus(dp.data() + prev * m, ct.data() + size_t(j) * m, m, inf);
+                }
+            }
+        }
+    };
+
+    int threads = params.threads > 0 ? params.threads : static_cast<int>(thread::hardware_concurrency());
+    threads = max(1, threads);
+    for (int k = 2; k <= m; ++k){
+        size_t lo = layerStart[k], hi = layerStart[k + 1];
+        int used = static_cast<int>(min<size_t>(threads, max<size_t>(1, (hi - lo) / 1024))); // >= 1024 sous ensembles / thread
+        if (used == 1){
+            relax(lo, hi);
+            continue;
+        }
+        vector<thread> workers;
+        for (int w = 0; w < used; ++w)
+            {workers.emplace_back(relax, lo + (hi - lo) * w / used, lo + (hi - lo) * (w + 1) / used);}
+        for (thread &th : workers)
+            {th.join();}
+    }
+
+    // fermeture du tour puis remontee : i tel que dp[prev][i] + c(i, j) == dp[S][j]
+    int last = 0;
+    T best = inf;
+    for (int j = 0; j < m; ++j){
+        T v = dp[full * m + j] + static_cast<T>(data.dist(j + 1, 0));
+        if (v < best){
+            best = v;
+            last = j;
+        }
+    }
+
+    vector<int> rev;
+    size_t S = full;
+    int j = last;
+    while (true){
+        rev.push_back(j + 1);
+        size_t prev = S ^ (size_t(1) << j);
+        if (prev == 0)
+            {break;}
+        int from = -1;
+        for (int i = 0; i < m && from < 0; ++i)
+            {if ((prev & (size_t(1) << i)) && dp[prev * m + i] + ct[size_t(j) * m + i] == dp[S * m + j]) from = i;}
+        S = prev;
+        j = from;
+    }
+
+    tour.assign(1, 0);
+    tour.insert(tour.end(), rev.rbegin(), rev.rend());
+    cost = static_cast<long long>(best);
+    solved = true;
+}
+
+void ATSP_HeldKarp::printSolution(){
+    if (!solved){
+        cerr << "Fail -- run solve() first in the main" << endl;
+        return;
+    }
+    cout << "Succes! (Held-Karp)" << endl;
+    cout << "Runtime : " << nsToSec(stats.optimizeNs) << " seconds" << endl;
+    cout << "Objective value = " << cost << endl;
+    cout << "Tour :";
+    for (int v : tour)
+        {cout << " " << v;}
+    cout << " " << tour.front() << endl;
+}
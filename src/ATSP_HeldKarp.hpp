@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include "ATSP_Data.hpp"
+#include "ATSP_Params.hpp"
+#include "ATSP_Stats.hpp"
+
+using namespace std;
+
+// ======================================================================
+// ============== HELD-KARP (programmation dynamique exacte) ============
+// ======================================================================
+// petites instances (n <= MAX_N) : pas d'environnement Gurobi, pas de modele
+// dp[S][j] == plus court chemin 0 -> j visitant exactement S (S sous ensemble de {1..n-1}, j dans S)
+// memoire 2^(n-1) * (n-1) valeurs (n == 20 : 40 Mo en int32)
+
+class ATSP_HeldKarp {
+
+private:
+    ATSPDataC data;
+    SolveStats stats;
+    SolverParams params; // threads (0 == tous les coeurs)
+
+    long long cost; // cout du tour optimal
+    vector<int> tour; // tour optimal depuis 0
+    bool solved;
+
+public:
+    static const int MAX_N = 24; // 2^23 * 23 * 4 o ~ 770 Mo
+
+    // Constructeur
+    ATSP_HeldKarp(ATSPDataC data);
+
+    // Setters & Getters
+    long long getterCost() const { return cost; }
+    const vector<int> &getterTour() const { return tour; }
+    bool getterSolved() const { return solved; }
+    SolveStats &getterStats() { return stats; }
+    void setterParams(const SolverParams &params) { this->params = params; }
+
+    void solve(); // DP + reconstruction du tour
+    void printSolution(); // affiche sol
+
+private:
+    template <typename T>
+    void run(T inf);
+};
@@ -1,12 +1,22 @@
 #include "ATSP_MTZ.hpp"
 
-ATSP_MTZ::ATSP_MTZ(ATSPDataC data) : data(data) {}
+ATSP_MTZ::ATSP_MTZ(ATSPDataC data, Formulation formulation)
+    : data(data), status(0), lazyCuts(0), userCuts(0), formulation(formulation) {}
 
 void ATSP_MTZ::solve() {
     try {
-        env = std::make_unique<GRBEnv>(true);
-        env->set("LogFile", "atsp_mtz.log");
-        env->start();
+        lazyCuts = 0;
+        userCuts = 0;
+        pool.clear();
+
+        stats.resetForSolve(); // garde lecture / estimation mesurees par l'appelant
+        long long buildStart = nowNs();
+
+        if (!env) {
+            env = std::make_shared<GRBEnv>(true);
+            env->set("LogFile", "atsp_mtz.log");
+            env->start();
+        }
 
         model = std::make_unique<GRBModel>(*env);
         GRBModel &modelRef = *model;
@@ -15,7 +25,14 @@ void ATSP_MTZ::solve() {
         // x_ij && u_i
         x = vector<vector<GRBVar>>(data.size, vector<GRBVar>(data.size));
         vector<vector<GRBVar>> &xRef = x;
-        vector<GRBVar> u(data.size);
+        u.assign(data.size, GRBVar());
+
+        // --arc-elim : arcs hors de tout tour <= upper fixes a 0 (optimum inchange)
+        vector<vector<char>> keep;
+        if (params.arcElim && !lagrangian.empty()) {
+            keep = reducedCostArcs(lagrangian, data.size, stats.arcsEliminated);
+        }
+        arcsFixed = !keep.empty();
 
         for (int i = 0; i < data.size; ++i) {
             // 1 <= u_i <= n-1 for i in N\{0}
@@ -27,7 +44,8 @@ void ATSP_MTZ::solve() {
             }
             for (int j = 0; j < data.size; ++j) {
                 if (i != j) {
-                    xRef[i][j] = modelRef.addVar(0.0, 1.0, data.distances[i][j], GRB_BINARY, "x(" + to_string(i) + "," + to_string(j) + ")");
+                    double ub = (keep.empty() || keep[i][j]) ? 1.0 : 0.0;
+                    xRef[i][j] = modelRef.addVar(0.0, ub, data.dist(i, j), GRB_BINARY, "x(" + to_string(i) + "," + to_string(j) + ")");
                 }
             }
         }
@@ -37,7 +55,7 @@ void ATSP_MTZ::solve() {
         for (int i = 0; i < data.size; ++i){
             for (int j = 0; j < data.size; ++j){
                 if (i != j){
-                    obj += data.distances[i][j] * xRef[i][j];
+                    obj += data.dist(i, j) * xRef[i][j];
                 }
             }
         }
@@ -70,27 +88,138 @@ void ATSP_MTZ::solve() {
         modelRef.addConstr(u[0] == 0, "u(0)");
 
         // u_j >= u_i + 1 - (n-1)(1-x[i][j]) for all i,j in N, i!=j, j!=0
-        for (int i = 1; i < data.size; ++i){
-            for (int j = 1; j < data.size; ++j){
-                if (i != j && j != 0){
-                    modelRef.addConstr(u[j] >= u[i] + 1 - (data.size - 1) * (1 - xRef[i][j]), "subtour(" + to_string(i) + "," + to_string(j) + ")");
+        // (MTZ paresseux : separees dans ATSP_MTZ_LazyCallback)
+        if (formulation == Formulation::Full){
+            for (int i = 1; i < data.size; ++i){
+                for (int j = 1; j < data.size; ++j){
+                    if (i != j && j != 0){
+                        modelRef.addConstr(u[j] >= u[i] + 1 - (data.size - 1) * (1 - xRef[i][j]), "subtour(" + to_string(i) + "," + to_string(j) + ")");
+                    }
                 }
             }
         }
 
-        modelRef.set(GRB_DoubleParam_TimeLimit, 180.0); //< définition du temps limite (en secondes)
-        modelRef.set(GRB_IntParam_Threads, 1);          //< définition du nombre de threads pouvant être utilisé
-        modelRef.write("model.lp");                     //< écriture du modèle PLNE dans le fichier donné en paramètre (optionnel)
+        modelRef.set(GRB_DoubleParam_TimeLimit, params.timeLimit); //< définition du temps limite (en secondes)
+        modelRef.set(GRB_IntParam_Threads, params.threads);        //< définition du nombre de threads pouvant être utilisé
+        stats.buildNs = nowNs() - buildStart;
+
+        runOptimize();
+    }
+    catch (GRBException e){
+        cerr << "Error code = " << e.getErrorCode() << endl;
+        cerr << e.getMessage() << endl;
+    }
+    catch (...){
+        cerr << "Exception during optimization" << endl;
+    }
+}
+
+void ATSP_MTZ::runOptimize(){
+    GRBModel &modelRef = *model;
+    ATSP_MTZ_Callback cb(&stats);                   //< trajectoire incumbent / borne
+    ATSP_MTZ_LazyCallback lazyCb(data.size, x, u, &lazyCuts, &userCuts, &stats, &pool); //< + MTZ violees
+    if (formulation == Formulation::Lazy){
+        modelRef.set(GRB_IntParam_LazyConstraints, 1);
+        modelRef.setCallback(&lazyCb);
+    }
+    else
+        {modelRef.setCallback(&cb);}
+    {
+        ScopedTimer optTimer(&stats.optimizeNs);
         modelRef.optimize();
+    }
+    modelRef.setCallback(nullptr); // callbacks detruits en sortie
+
+    setterStatus(modelRef.get(GRB_IntAttr_Status));
+}
+
+vector<int> ATSP_MTZ::getterTour(){
+    vector<int> tour;
+    if (!model)
+        {return tour;}
+    try{
+        if (model->get(GRB_IntAttr_SolCount) == 0)
+            {return tour;}
+        int n = data.size;
+        vector<int> succ(n, -1);
+        for (int i = 0; i < n; ++i){
+            for (int j = 0; j < n; ++j){
+                if (i != j && x[i][j].get(GRB_DoubleAttr_X) > 0.5)
+                    {succ[i] = j;}
+            }
+        }
+        for (int v = 0; static_cast<int>(tour.size()) < n; v = succ[v]){
+            if (v < 0 || (!tour.empty() && v == 0))
+                {return vector<int>();}
+            tour.push_back(v);
+        }
+        if (succ[tour.back()] != 0)
+            {tour.clear();}
+    }
+    catch (GRBException e)
+        {tour.clear();}
+    return tour;
+}
+
+void ATSP_MTZ::reoptimize(const vector<ArcCost> &changes){
+    if (!model){
+        cerr << "Fail! (Model not available; run solve() first)" << endl;
+        return;
+    }
+    try{
+        GRBModel &modelRef = *model;
+        vector<int> tour = getterTour(); // avant modification (sol effacee ensuite)
+
+        lazyCuts = 0;
+        userCuts = 0;
+        stats.resetForSolve();
+        long long buildStart = nowNs();
+
+        // --arc-elim : arcs elimines d'apres les anciens couts => rendus (ub 1), sinon re-solve restreint
+        int n = data.size;
+        if (arcsFixed){
+            for (int i = 0; i < n; ++i)
+                {for (int j = 0; j < n; ++j) if (i != j) x[i][j].set(GRB_DoubleAttr_UB, 1.0);}
+            arcsFixed = false;
+        }
+
+        // couts : modele modifie sur place => Gurobi repart de la derniere base
+        for (const ArcCost &c : changes){
+            if (c.i == c.j || c.i < 0 || c.j < 0 || c.i >= data.size || c.j >= data.size)
+                {continue;}
+            data.updateWeight(c.i, c.j, c.cost);
+            x[c.i][c.j].set(GRB_DoubleAttr_Obj, static_cast<double>(c.cost));
+        }
+
+        // MTZ paresseux : contraintes du callback => lignes
+        for (; pool.inModel < pool.arcs.size(); ++pool.inModel){
+            int i = pool.arcs[pool.inModel].first, j = pool.arcs[pool.inModel].second;
+            modelRef.addConstr(u[j] >= u[i] + 1 - (n - 1) * (1 - x[i][j]));
+            stats.seededCuts++;
+        }
+
+        // tour precedent toujours realisable => MIP start (x + rangs u)
+        if (!tour.empty()){
+            for (int i = 0; i < n; ++i){
+                for (int j = 0; j < n; ++j)
+                    {if (i != j) x[i][j].set(GRB_DoubleAttr_Start, 0.0);}
+            }
+            for (int t = 0; t < n; ++t){
+                x[tour[t]][tour[(t + 1) % n]].set(GRB_DoubleAttr_Start, 1.0);
+                u[tour[t]].set(GRB_DoubleAttr_Start, static_cast<double>(t));
+            }
+        }
+        stats.buildNs = nowNs() - buildStart;
 
-        setterStatus(modelRef.get(GRB_IntAttr_Status));
+        modelRef.set(GRB_DoubleParam_TimeLimit, params.timeLimit);
+        runOptimize();
     }
     catch (GRBException e){
-        cout << "Error code = " << e.getErrorCode() << endl;
-        cout << e.getMessage() << endl;
+        cerr << "Error code = " << e.getErrorCode() << endl;
+        cerr << e.getMessage() << endl;
     }
     catch (...){
-        cout << "Exception during optimization" << endl;
+        cerr << "Exception during optimization" << endl;
     }
 }
 
@@ -1,27 +1,229 @@
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <set>
 #include "gurobi_c++.h"
 
 using namespace std;
 
 #include "ATSP_Data.hpp"
+#include "ATSP_Stats.hpp"
+#include "ATSP_Params.hpp"
+#include "ATSP_Sep.hpp"
+#include "ATSP_Bound.hpp"
 
 #pragma once
 
+// callback MTZ : seulement la trajectoire incumbent / borne (GRB_CB_MIP)
+class ATSP_MTZ_Callback : public GRBCallback {
+protected:
+    SolveStats *stats;
+
+public:
+    ATSP_MTZ_Callback(SolveStats *stats) : stats(stats) {}
+
+protected:
+    void callback(){
+        if (where != GRB_CB_MIP || !stats)
+            {return;}
+        try{
+            stats->addTrajectory(getDoubleInfo(GRB_CB_RUNTIME), getDoubleInfo(GRB_CB_MIP_OBJBST),
+                                 getDoubleInfo(GRB_CB_MIP_OBJBND));
+        }
+        catch (GRBException e)
+            { cerr << "Erreur callback : " << e.getMessage() << endl; }
+    }
+};
+
+// arcs (i, j) des contraintes MTZ ajoutees par le callback (perdues par Gurobi apres optimize())
+// => reposees en lignes avant un re-solve (reoptimize)
+struct MTZPool{
+    vector<pair<int, int>> arcs;
+    size_t inModel = 0; // [0, inModel) deja lignes du modele
+
+    void add(int i, int j){
+        lock_guard<mutex> guard(m);
+        if (seen.insert(make_pair(i, j)).second)
+            {arcs.push_back(make_pair(i, j));}
+    }
+
+    void clear(){
+        lock_guard<mutex> guard(m);
+        arcs.clear();
+        seen.clear();
+        inModel = 0;
+    }
+
+private:
+    mutex m; // callback multi thread
+    set<pair<int, int>> seen;
+};
+
+// buffers du MTZ paresseux d'un thread (cf. CutScratch) : vars x puis u a plat, point, coupes
+struct MTZScratch{
+    long owner = -1;      // id du callback qui les a dimensionnes
+    vector<GRBVar> vars;  // x[i][j] i != j (ordre ligne) puis u[0..n-1]
+    vector<int> arcTail;  // i de vars[k], k < nb arcs
+    vector<int> arcHead;  // j de vars[k]
+    FlatPoint sol;        // x courant n x n a plat (diagonale == 0)
+    vector<double> uVal;  // u courant
+    vector<MTZCut> cuts;
+
+    void init(long id, int n, const vector<vector<GRBVar>> &x, const vector<GRBVar> &u){
+        owner = id;
+        vars.clear();
+        arcTail.clear();
+        arcHead.clear();
+        for (int i = 0; i < n; ++i){
+            for (int j = 0; j < n; ++j){
+                if (i != j){
+                    vars.push_back(x[i][j]);
+                    arcTail.push_back(i);
+                    arcHead.push_back(j);
+                }
+            }
+        }
+        vars.insert(vars.end(), u.begin(), u.end());
+        sol.assign(n);
+        uVal.assign(n, 0.0);
+    }
+};
+
+// MTZ paresseux : contraintes MTZ violees ajoutees en lazy (MIPSOL) / user cut (MIPNODE)
+class ATSP_MTZ_LazyCallback : public ATSP_MTZ_Callback {
+private:
+    int n;                     // taille instance
+    vector<vector<GRBVar>> &x; // ref vars x
+    vector<GRBVar> &u;         // ref vars u
+
+    atomic<int> *lazyCuts; // ptr comptaur lazy
+    atomic<int> *userCuts; //  "     "     user
+
+    MTZPool *pool; // contraintes ajoutees recopiees (nullptr == pas de pool)
+
+    long id; // identifiant unique => buffers thread_local redimensionnes si autre callback
+
+    static long nextId(){
+        static atomic<long> counter(0);
+        return counter++;
+    }
+
+public:
+    ATSP_MTZ_LazyCallback(int n, vector<vector<GRBVar>> &x, vector<GRBVar> &u, atomic<int> *lazyCuts,
+                          atomic<int> *userCuts, SolveStats *stats, MTZPool *pool = nullptr)
+        : ATSP_MTZ_Callback(stats), n(n), x(x), u(u), lazyCuts(lazyCuts), userCuts(userCuts), pool(pool),
+          id(nextId()) {}
+
+private:
+    // buffers du thread courant (1 allocation par thread et par callback)
+    MTZScratch &scratch(){
+        thread_local MTZScratch w;
+        if (w.owner != id)
+            {w.init(id, n, x, u);}
+        return w;
+    }
+
+    // x et u du MIPSOL / MIPNODE en 1 seul appel Gurobi => w.sol, w.uVal
+    // (l'API C++ renvoie un tableau alloue par new[] => 1 delete[] par appel)
+    void fetchPoint(MTZScratch &w){
+        int nVars = static_cast<int>(w.vars.size()), nArcs = static_cast<int>(w.arcTail.size());
+        double *vals = (where == GRB_CB_MIPSOL) ? getSolution(w.vars.data(), nVars)
+                                                : getNodeRel(w.vars.data(), nVars);
+        for (int k = 0; k < nArcs; ++k)
+            {w.sol[w.arcTail[k]][w.arcHead[k]] = vals[k];}
+        copy(vals + nArcs, vals + nVars, w.uVal.begin());
+        delete[] vals;
+    }
+
+protected:
+    void callback(){
+        if (where == GRB_CB_MIP)
+            {ATSP_MTZ_Callback::callback(); return;} // trajectoire
+
+        if (where != GRB_CB_MIPSOL && where != GRB_CB_MIPNODE)
+            {return;} // rien a separer
+
+        ScopedTimer timer(stats ? &stats->callbackNs : nullptr, stats);
+        if (stats)
+            {stats->add(stats->callbackCalls, 1);}
+
+        try{
+            if (where == GRB_CB_MIPNODE && getIntInfo(GRB_CB_MIPNODE_STATUS) != GRB_OPTIMAL)
+                {return;} // relax non optimale
+
+            bool integral = (where == GRB_CB_MIPSOL);
+            MTZScratch &w = scratch(); // buffers du thread courant
+            vector<MTZCut> &cuts = w.cuts;
+            fetchPoint(w);
+            if (findMTZViolations(w.sol, w.uVal, cuts) == 0)
+                {return;}
+
+            for (const MTZCut &c : cuts){
+                // u_j >= u_i + 1 - (n-1)(1 - x_ij)
+                GRBTempConstr row = u[c.j] >= u[c.i] + 1 - (n - 1) * (1 - x[c.i][c.j]);
+                if (pool)
+                    {pool->add(c.i, c.j);}
+                if (integral){
+                    addLazy(row);
+                    if (lazyCuts)
+                        {(*lazyCuts)++;}
+                }
+                else{
+                    addCut(row);
+                    if (userCuts)
+                        {(*userCuts)++;}
+                }
+                if (stats)
+                    {stats->addCut(c.violation);}
+            }
+            if (stats)
+                {stats->addRound(static_cast<int>(cuts.size()));}
+        }
+        catch (GRBException e)
+            { cerr << "Erreur callback : " << e.getMessage() << endl; }
+    }
+};
+
 class ATSP_MTZ {
 
 private:
     ATSPDataC data;
-    std::unique_ptr<GRBEnv> env;
+    std::shared_ptr<GRBEnv> env; // propre au solveur, ou partage (setterEnv, --serve)
     std::unique_ptr<GRBModel> model;
     int status;
 
     vector<vector<GRBVar>> x; // x[i][j] == var decision arc i->j
+    vector<GRBVar> u;         // u_i == rang de i dans le tour
+
+    atomic<int> lazyCuts; // nb lazy cuts ajoutees (MTZ paresseux)
+    atomic<int> userCuts; // "  user   "     "
+
+    SolveStats stats; // instrumentation
+
+    SolverParams params; // threads, temps limite
+
+    LagrangianBound lagrangian; // borne 1-arborescence (params.arcElim => arcs elimines a ub 0)
+    bool arcsFixed = false;     // arcs a ub 0 dans le modele (--arc-elim), rendus par reoptimize
+
+    MTZPool pool; // MTZ paresseux : contraintes du callback, reposees par reoptimize
+
+public:
+    enum class Formulation{
+        Full, // (n-1)(n-2) contraintes MTZ posees d'avance
+        Lazy  // degres + u seulement, MTZ separees dans le callback
+    };
+
+private:
+    Formulation formulation;
+
+    void runOptimize(); // callback (trajectoire / MTZ paresseux) + optimize()
 
 public:
     // Constructeur
-    ATSP_MTZ(ATSPDataC data);
+    ATSP_MTZ(ATSPDataC data, Formulation formulation = Formulation::Full);
 
     // Setters & Getters
     void setterX(vector<vector<GRBVar>> &x) { this->x = x; }
@@ -29,7 +231,20 @@ public:
     GRBModel *getterModel() { return this->model.get(); }
     vector<vector<GRBVar>> &getterX() { return this->x; }
     int getterStatus() { return this->status; }
+    SolveStats &getterStats() { return stats; }
+    int getTotalCuts() const { return lazyCuts + userCuts; } // MTZ paresseux seulement
+    void setterParams(const SolverParams &params) { this->params = params; }
+    void setterEnv(const std::shared_ptr<GRBEnv> &env) { this->env = env; } // avant solve() : pas de demarrage d'env
+    void setterLagrangian(const LagrangianBound &lagrangian) { this->lagrangian = lagrangian; }
 
     void solve(); // build + solve model
     void printSolution();  // affiche sol
+
+    // apres solve() : nouveaux couts sur le modele existant puis re-solve ; garde les contraintes MTZ
+    // du callback (Lazy), la base LP de Gurobi et le dernier tour (MIP start x + u)
+    // --arc-elim : elimination faite avec les anciens couts => arcs fixes a 0 rendus au modele (ub 1)
+    void reoptimize(const vector<ArcCost> &changes);
+
+    // successeurs depuis 0 de la derniere sol ; vide si pas de sol
+    vector<int> getterTour();
 };
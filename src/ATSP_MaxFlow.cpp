@@ -0,0 +1,369 @@
+#include "ATSP_MaxFlow.hpp"
+#include "ATSP_Sep.hpp"
+#include <algorithm>
+
+using namespace std;
+
+constexpr double PushRelabel::EPS;
+
+static const int ALPHA = 6;  // == hi_pr
+static const int BETA = 12;
+static const double GLOB_UPDT_FREQ = 0.5;
+
+template <typename Point>
+void PushRelabel::buildFrom(const Point &x){
+    n = static_cast<int>(x.size());
+    first.assign(n + 1, 0);
+
+    // degres : 1 paire par {i, j} portant de la capacite dans un sens ou l'autre
+    for (int i = 0; i < n; ++i){
+        for (int j = i + 1; j < n; ++j){
+            if (x[i][j] > EPS || x[j][i] > EPS){
+                first[i + 1]++;
+                first[j + 1]++;
+            }
+        }
+    }
+    for (int i = 0; i < n; ++i)
+        {first[i + 1] += first[i];}
+
+    int m = first[n];
+    head.resize(m);
+    rev.resize(m);
+    cap.resize(m);
+    res.resize(m);
+    // arcs de chaque sommet tries par voisin (paires {i < v} puis {v < j}) => fusion a chaud
+    queue.resize(n);
+    vector<int> &pos = queue; // libre jusqu'au 1er minCut (BFS)
+    copy(first.begin(), first.end() - 1, pos.begin());
+    for (int i = 0; i < n; ++i){
+        for (int j = i + 1; j < n; ++j){
+            if (x[i][j] > EPS || x[j][i] > EPS){
+                int a = pos[i]++, b = pos[j]++;
+                head[a] = j;
+                head[b] = i;
+                rev[a] = b;
+                rev[b] = a;
+                cap[a] = (x[i][j] > EPS) ? x[i][j] : 0.0;
+                cap[b] = (x[j][i] > EPS) ? x[j][i] : 0.0;
+            }
+        }
+    }
+
+    excess.resize(n);
+    d.resize(n);
+    current.resize(n);
+    bNext.resize(n + 1);
+    bPrev.resize(n + 1);
+    firstActive.resize(n + 1);
+    firstInactive.resize(n + 1);
+}
+
+void PushRelabel::build(const vector<vector<double>> &x) { buildFrom(x); }
+void PushRelabel::build(const FlatPoint &x) { buildFrom(x); }
+
+// ---------------- seaux : actifs (simple chainage), inactifs (double chainage) ----------------
+
+inline void PushRelabel::aAdd(int l, int i){
+    bNext[i] = firstActive[l];
+    firstActive[l] = i;
+    aMin = min(aMin, l);
+    aMax = max(aMax, l);
+}
+
+inline void PushRelabel::iAdd(int l, int i){
+    int next = firstInactive[l];
+    bNext[i] = next;
+    bPrev[i] = n;
+    bPrev[next] = i;
+    firstInactive[l] = i;
+}
+
+inline void PushRelabel::iDelete(int l, int i){
+    int next = bNext[i];
+    if (firstInactive[l] == i){
+        firstInactive[l] = next;
+        bPrev[next] = n;
+    }
+    else{
+        int prev = bPrev[i];
+        bNext[prev] = next;
+        bPrev[next] = prev;
+    }
+}
+
+// labels exacts : BFS arriere depuis le puits dans le residuel
+void PushRelabel::globalUpdate(){
+    fill(d.begin(), d.end(), n);
+    d[sink] = 0;
+    for (int l = 0; l <= dMax; ++l){
+        firstActive[l] = n;
+        firstInactive[l] = n;
+    }
+    dMax = aMax = 0;
+    aMin = n;
+
+    int qHead = 0, qTail = 0;
+    queue[qTail++] = sink;
+    while (qHead < qTail){
+        int i = queue[qHead++];
+        int jD = d[i] + 1;
+        for (int a = first[i]; a < first[i + 1]; ++a){
+            int j = head[a];
+            if (d[j] != n || j == source || res[rev[a]] <= EPS)
+                {continue;}
+            d[j] = jD;
+            current[j] = first[j];
+            dMax = max(dMax, jD);
+            if (excess[j] > EPS)
+                {aAdd(jD, j);}
+            else
+                {iAdd(jD, j);}
+            queue[qTail++] = j;
+        }
+    }
+}
+
+// seau emptyB vide : sommets au dessus coupes du puits
+void PushRelabel::gap(int emptyB){
+    for (int l = emptyB + 1; l <= dMax; ++l){
+        for (int i = firstInactive[l]; i != n; i = bNext[i])
+            {d[i] = n;}
+        firstInactive[l] = n;
+    }
+    dMax = aMax = emptyB - 1;
+}
+
+void PushRelabel::relabel(int i){
+    work += BETA;
+    int minD = n, minA = -1;
+    for (int a = first[i]; a < first[i + 1]; ++a){
+        work++;
+        if (res[a] > EPS && d[head[a]] < minD){
+            minD = d[head[a]];
+            minA = a;
+        }
+    }
+    minD++;
+    d[i] = n;
+    if (minD < n){
+        d[i] = minD;
+        current[i] = minA;
+        dMax = max(dMax, minD);
+    }
+}
+
+// pousse l'exces de i (plus haut label) jusqu'a ce que i soit inactif ou coupe du puits
+void PushRelabel::discharge(int i){
+    while (true){
+        int l = d[i], jD = l - 1;
+        int a = current[i], stop = first[i + 1];
+        for (; a < stop; ++a){
+            if (res[a] <= EPS)
+                {continue;}
+            int j = head[a];
+            if (d[j] != jD)
+                {continue;}
+
+            double delta = (res[a] < excess[i] - EPS) ? res[a] : excess[i];
+            res[a] -= delta;
+            res[rev[a]] += delta;
+            if (j != sink && excess[j] >= -EPS && excess[j] <= EPS){
+                iDelete(jD, j);
+                aAdd(jD, j);
+            }
+            excess[j] += delta;
+            excess[i] -= delta;
+            if (excess[i] >= -EPS && excess[i] <= EPS)
+                {break;}
+        }
+
+        if (a < stop){
+            current[i] = a;
+            iAdd(l, i);
+            return;
+        }
+
+        relabel(i);
+        if (firstActive[l] == n && firstInactive[l] == n){
+            gap(l);
+            d[i] = n; // au dessus du trou
+        }
+        if (d[i] == n)
+            {return;}
+    }
+}
+
+// source saturee
+void PushRelabel::saturateSource(){
+    for (int a = first[source]; a < first[source + 1]; ++a){
+        double delta = res[a];
+        res[a] = 0.0;
+        res[rev[a]] += delta;
+        excess[head[a]] += delta;
+    }
+}
+
+// flot reprojete : arcs reduits => deficits (exces < 0) en aval ; chaque deficit est renvoye en aval en
+// reduisant le flot sortant, jusqu'au puits ou a un sommet en exces => preflot (exces >= 0 hors source)
+// le flot ne fait que baisser => termine ; arcs sortants de la source satures avant, jamais touches
+// 1 sommet empile seulement quand il passe en deficit => pile <= n ; false si un deficit reste (arrondis)
+bool PushRelabel::repairDeficits(){
+    vector<int> &stack = queue;
+    int top = 0;
+    for (int v = 0; v < n; ++v){
+        if (v != source && excess[v] < -EPS)
+            {stack[top++] = v;}
+    }
+    while (top > 0){
+        int v = stack[--top];
+        for (int a = first[v]; a < first[v + 1] && excess[v] < -EPS; ++a){
+            double f = cap[a] - res[a];
+            if (f <= 0.0)
+                {continue;}
+            double delta = min(f, -excess[v]);
+            int w = head[a];
+            res[a] += delta;
+            res[rev[a]] -= delta;
+            excess[v] += delta;
+            bool wasOk = excess[w] >= -EPS;
+            excess[w] -= delta;
+            if (w != source && wasOk && excess[w] < -EPS)
+                {stack[top++] = w;}
+        }
+        if (excess[v] < -EPS)
+            {return false;}
+    }
+    return true;
+}
+
+// etape 1 (preflot max) depuis res / excess courants ; renvoie le flot entrant au puits
+double PushRelabel::maxPreflow(){
+    dMax = n - 1;
+    globalUpdate();
+    work = 0;
+    long long nm = static_cast<long long>(ALPHA) * n + arcs();
+
+    // sommet actif de plus haut label
+    while (aMax >= aMin){
+        int i = firstActive[aMax];
+        if (i == n){
+            aMax--;
+            continue;
+        }
+        firstActive[aMax] = bNext[i];
+        discharge(i);
+        if (work * GLOB_UPDT_FREQ > nm){
+            globalUpdate();
+            work = 0;
+        }
+    }
+
+    sideReady = false; // d[v] < n <=> v atteint le puits : relabel global a la demande (inSinkSide)
+    return excess[sink];
+}
+
+double PushRelabel::minCut(int source, int sink){
+    this->source = source;
+    this->sink = sink;
+    res.assign(cap.begin(), cap.end()); // (res echange par swapResidual)
+    fill(excess.begin(), excess.end(), 0.0);
+    for (int i = 0; i < n; ++i)
+        {current[i] = first[i];}
+
+    saturateSource();
+    return maxPreflow();
+}
+
+void PushRelabel::arcMap(const vector<int> &prevFirst, const vector<int> &prevHead, vector<int> &prevArc) const{
+    prevArc.assign(head.size(), -1);
+    for (int i = 0; i < n; ++i){
+        int o = prevFirst[i], oEnd = prevFirst[i + 1];
+        for (int a = first[i]; a < first[i + 1]; ++a){
+            while (o < oEnd && prevHead[o] < head[a])
+                {++o;}
+            if (o < oEnd && prevHead[o] == head[a])
+                {prevArc[a] = o;}
+        }
+    }
+}
+
+// labels non repris : relabel global (exact) au depart de maxPreflow, O(m) comme la reprojection
+double PushRelabel::minCut(int source, int sink, const vector<int> &prevArc, const vector<double> &prevCap,
+                           const vector<double> &prevRes){
+    this->source = source;
+    this->sink = sink;
+    res.assign(cap.begin(), cap.end());
+    fill(excess.begin(), excess.end(), 0.0);
+
+    // flot net de la paire {i < j}, borne par les nouvelles capacites
+    for (int i = 0; i < n; ++i){
+        current[i] = first[i];
+        for (int a = first[i]; a < first[i + 1]; ++a){
+            int o = prevArc[a], j = head[a];
+            if (o < 0 || j < i)
+                {continue;}
+
+            double f = min(prevCap[o] - prevRes[o], cap[a]);
+            f = max(f, -cap[rev[a]]);
+            res[a] -= f;
+            res[rev[a]] += f;
+            excess[i] -= f;
+            excess[j] += f;
+        }
+    }
+
+    saturateSource();
+    if (!repairDeficits())
+        {return minCut(source, sink);}
+    return maxPreflow();
+}
+
+// ---------------- WarmMinCut ----------------
+
+void WarmMinCut::savePending(){
+    if (pending >= 0)
+        {flow.swapResidual(saved[pending].res);}
+    pending = -1;
+}
+
+void WarmMinCut::build(const vector<vector<double>> &x){
+    savePending();
+    flow.build(x);
+    shared_ptr<Support> g = make_shared<Support>();
+    g->first = flow.arcStart();
+    g->head = flow.arcHead();
+    g->cap = flow.capacity();
+    current = g;
+    maps.clear();
+    if (static_cast<int>(saved.size()) != flow.nodes())
+        {saved.assign(flow.nodes(), Saved());}
+}
+
+double WarmMinCut::minCut(int source, int sink){
+    savePending();
+    Saved &s = saved[sink];
+    double val = 0.0;
+    if (s.graph && s.source == source){
+        // 1 fusion par graphe precedent (en general le seul : point d'avant), partagee par ses puits
+        const vector<int> *prevArc = nullptr;
+        for (const auto &m : maps){
+            if (m.first == s.graph)
+                {prevArc = &m.second;}
+        }
+        if (!prevArc){
+            maps.emplace_back(s.graph, vector<int>());
+            flow.arcMap(s.graph->first, s.graph->head, maps.back().second);
+            prevArc = &maps.back().second;
+        }
+        val = flow.minCut(source, sink, *prevArc, s.graph->cap, s.res);
+        warm++;
+    }
+    else
+        {val = flow.minCut(source, sink);}
+
+    s.source = source;
+    s.graph = current;
+    pending = sink; // residuels sauves au prochain minCut / build
+    return val;
+}
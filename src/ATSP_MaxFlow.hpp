@@ -0,0 +1,138 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+struct FlatPoint; // ATSP_Sep.hpp
+
+// ======================================================================
+// ============== MAX FLOW PUSH-RELABEL (CSR / SoA) =====================
+// ======================================================================
+// meme algorithme que hi_pr (plus haut label, relabel global, gap) sur un graphe compact :
+//   arcs de i == [first[i], first[i + 1]) ; head / rev en int32, capacites residuelles contigues
+//   1 paire d'arcs par {i, j} avec x_ij ou x_ji > EPS (hi_pr : 1 paire par arc, + matrice reparsee a chaque puits)
+// graphe construit 1 fois par point, reutilise pour tous les puits (seules les capacites residuelles sont remises)
+// etape 2 de hi_pr (preflot -> flot) inutile pour la coupe : les sommets qui atteignent le puits dans le
+// residuel d'un preflot max forment le cote puits minimal de la coupe min, le meme que pour tout flot max
+// 1 instance par thread (pas d'etat global)
+
+class PushRelabel{
+public:
+    static constexpr double EPS = 0.00001; // == hi_pr
+
+    // arcs i -> j de capacite x[i][j] > EPS (diagonale ignoree)
+    void build(const vector<vector<double>> &x);
+    void build(const FlatPoint &x);
+
+    // valeur de la coupe min source -> sink (== flot max) ; cote puits : inSinkSide
+    double minCut(int source, int sink);
+
+    // reprise a chaud : flot d'un graphe precedent de meme n (capacites prevCap, residuels prevRes),
+    // prevArc[a] == arc de la meme paire dans ce graphe (-1 sinon, cf. arcMap) ; reprojete sur le graphe
+    // courant puis repare en preflot (cf. ATSP_MaxFlow.cpp) ; meme resultat que minCut
+    double minCut(int source, int sink, const vector<int> &prevArc, const vector<double> &prevCap,
+                  const vector<double> &prevRes);
+
+    // prevArc pour un graphe precedent (prevFirst / prevHead) : fusion des listes triees par voisin
+    void arcMap(const vector<int> &prevFirst, const vector<int> &prevHead, vector<int> &prevArc) const;
+
+    // echange les residuels du dernier minCut avec out (sauvegarde sans copie ; inSinkSide ensuite interdit)
+    void swapResidual(vector<double> &out) { res.swap(out); }
+    const vector<int> &arcStart() const { return first; }
+    const vector<int> &arcHead() const { return head; }
+    const vector<double> &capacity() const { return cap; }
+
+    // v atteint le puits dans le residuel (== dist[v] <= n - 1 de directed_min_cut)
+    // labels exacts calcules au 1er appel apres minCut (balayage : seulement pour les puits violes)
+    bool inSinkSide(int v){
+        if (!sideReady){
+            globalUpdate();
+            sideReady = true;
+        }
+        return d[v] < n;
+    }
+
+    int nodes() const { return n; }
+    int arcs() const { return static_cast<int>(head.size()); }
+
+private:
+    int n = 0;
+    int source = 0, sink = 0;
+
+    // graphe (CSR)
+    vector<int> first;   // n + 1
+    vector<int> head;    // sommet d'arrivee
+    vector<int> rev;     // arc inverse
+    vector<double> cap;  // capacites initiales
+    vector<double> res;  // capacites residuelles (flux courant)
+
+    // sommets (SoA) ; listes de seaux chainees par indices, n == sentinelle
+    vector<double> excess;
+    vector<int> d;       // labels de distance
+    vector<int> current; // arc courant
+    vector<int> bNext, bPrev;
+    vector<int> firstActive, firstInactive; // par label
+    vector<int> queue;   // BFS
+
+    int dMax = 0, aMax = 0, aMin = 0;
+    long long work = 0;  // scans d'arcs depuis le dernier relabel global
+    bool sideReady = true; // d == distances exactes au puits dans le residuel
+
+    template <typename Point>
+    void buildFrom(const Point &x);
+
+    void aAdd(int l, int i);
+    void iAdd(int l, int i);
+    void iDelete(int l, int i);
+
+    void saturateSource();
+    bool repairDeficits();
+    double maxPreflow();
+
+    void globalUpdate();
+    void gap(int emptyB);
+    void relabel(int i);
+    void discharge(int i);
+};
+
+// ======================================================================
+// ============== MIN CUT A CHAUD (rounds successifs de CUT_LP) =========
+// ======================================================================
+// 2 points LP consecutifs ne different que sur quelques arcs : chaque couple (source, puits) garde
+// son flot du dernier calcul et repart de lui au point suivant (PushRelabel::minCut a chaud)
+// le flot (residuels) est garde avec le graphe sur lequel il a ete calcule (partage entre puits, libere
+// avec le dernier) ; memoire : 1 double par arc du support et par puits
+
+class WarmMinCut{
+public:
+    // nouveau point : graphe reconstruit, flots gardes
+    void build(const vector<vector<double>> &x);
+
+    // == PushRelabel::minCut ; a chaud si le couple a deja ete calcule sur un point de meme taille
+    double minCut(int source, int sink);
+    bool inSinkSide(int v) { return flow.inSinkSide(v); }
+
+    long long warmCalls() const { return warm; }
+
+private:
+    struct Support{
+        vector<int> first, head;
+        vector<double> cap;
+    };
+    struct Saved{
+        int source = -1;
+        shared_ptr<const Support> graph;
+        vector<double> res; // residuels sur graph
+    };
+
+    PushRelabel flow;
+    shared_ptr<const Support> current;
+    vector<Saved> saved; // par puits
+    int pending = -1;    // puits du dernier minCut : residuels encore dans flow (inSinkSide)
+    vector<pair<shared_ptr<const Support>, vector<int>>> maps; // arcMap par graphe precedent, videe a chaque build
+    long long warm = 0;
+
+    void savePending();
+};
@@ -0,0 +1,206 @@
+#include "ATSP_Neighbors.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace std;
+
+KdTree::KdTree(const NodeCoords &coords) : metric(coords.metric), dim(2){
+    int n = coords.size();
+    pts.resize(n);
+    if (metric == CoordMetric::Geo){
+        // vecteur unitaire (lat, lon) : la corde croit avec l'angle, donc avec la distance GEO
+        dim = 3;
+        for (int i = 0; i < n; ++i)
+            {pts[i] = {coords.cosLat[i] * coords.cosLon[i], coords.cosLat[i] * coords.sinLon[i], coords.sinLat[i]};}
+    }
+    else{
+        for (int i = 0; i < n; ++i)
+            {pts[i] = {coords.x[i], coords.y[i], 0.0};}
+    }
+
+    idx.resize(n);
+    for (int i = 0; i < n; ++i)
+        {idx[i] = i;}
+    split.assign(n, 0);
+    build(0, n);
+}
+
+void KdTree::build(int lo, int hi){
+    if (hi - lo <= LEAF)
+        {return;}
+
+    // coupe sur l'axe le plus etale, a la mediane
+    int best = 0;
+    double bestSpread = -1.0;
+    for (int d = 0; d < dim; ++d){
+        double mn = pts[idx[lo]][d], mx = mn;
+        for (int t = lo + 1; t < hi; ++t){
+            mn = min(mn, pts[idx[t]][d]);
+            mx = max(mx, pts[idx[t]][d]);
+        }
+        if (mx - mn > bestSpread){
+            bestSpread = mx - mn;
+            best = d;
+        }
+    }
+
+    int mid = lo + (hi - lo) / 2;
+    nth_element(idx.begin() + lo, idx.begin() + mid, idx.begin() + hi,
+                [&](int a, int b) { return pts[a][best] < pts[b][best]; });
+    split[mid] = static_cast<unsigned char>(best);
+    build(lo, mid);
+    build(mid + 1, hi);
+}
+
+// EUC_2D / CEIL_2D / ATT / GEO : carre de la norme euclidienne (meme ordre que la distance TSPLIB)
+double KdTree::pointDist(const array<double, 3> &a, const array<double, 3> &b) const{
+    double dx = a[0] - b[0], dy = a[1] - b[1];
+    if (metric == CoordMetric::Man2D)
+        {return fabs(dx) + fabs(dy);}
+    if (metric == CoordMetric::Max2D)
+        {return max(fabs(dx), fabs(dy));}
+    double dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+double KdTree::axisBound(double diff) const{
+    if (metric == CoordMetric::Man2D || metric == CoordMetric::Max2D)
+        {return fabs(diff);}
+    return diff * diff;
+}
+
+// tas max des k meilleurs (dist, sommet)
+struct KdTree::Query{
+    int self;
+    int k;
+    array<double, 3> p;
+    vector<pair<double, int>> heap;
+
+    double worst() const { return static_cast<int>(heap.size()) < k ? HUGE_VAL : heap.front().first; }
+
+    void offer(double d, int v){
+        if (v == self)
+            {return;}
+        if (static_cast<int>(heap.size()) < k){
+            heap.emplace_back(d, v);
+            push_heap(heap.begin(), heap.end());
+        }
+        else if (make_pair(d, v) < heap.front()){
+            pop_heap(heap.begin(), heap.end());
+            heap.back() = make_pair(d, v);
+            push_heap(heap.begin(), heap.end());
+        }
+    }
+};
+
+void KdTree::search(Query &q, int lo, int hi) const{
+    if (hi - lo <= LEAF){
+        for (int t = lo; t < hi; ++t)
+            {q.offer(pointDist(q.p, pts[idx[t]]), idx[t]);}
+        return;
+    }
+
+    int mid = lo + (hi - lo) / 2;
+    int d = split[mid];
+    q.offer(pointDist(q.p, pts[idx[mid]]), idx[mid]);
+
+    double diff = q.p[d] - pts[idx[mid]][d];
+    if (diff < 0.0){
+        search(q, lo, mid);
+        if (axisBound(diff) <= q.worst())
+            {search(q, mid + 1, hi);}
+    }
+    else{
+        search(q, mid + 1, hi);
+        if (axisBound(diff) <= q.worst())
+            {search(q, lo, mid);}
+    }
+}
+
+void KdTree::nearest(int i, int k, vector<int> &out) const{
+    Query q;
+    q.self = i;
+    q.k = min(k, static_cast<int>(pts.size()) - 1);
+    q.p = pts[i];
+    q.heap.reserve(q.k + 1);
+    out.clear();
+    if (q.k <= 0)
+        {return;}
+
+    search(q, 0, static_cast<int>(pts.size()));
+    for (const pair<double, int> &e : q.heap)
+        {out.push_back(e.second);}
+}
+
+// trie chaque ligne par (cout, sommet) => graphe deterministe
+static void sortRows(CandidateGraph &g){
+    vector<pair<long long, int>> row;
+    for (int i = 0; i < g.n; ++i){
+        row.clear();
+        for (int e = g.first[i]; e < g.first[i + 1]; ++e)
+            {row.emplace_back(g.cost[e], g.heads[e]);}
+        sort(row.begin(), row.end());
+        for (int e = g.first[i], t = 0; e < g.first[i + 1]; ++e, ++t){
+            g.cost[e] = row[t].first;
+            g.heads[e] = row[t].second;
+        }
+    }
+}
+
+CandidateGraph nearestNeighborGraph(const NodeCoords &coords, int k){
+    CandidateGraph g;
+    g.n = coords.size();
+    int kk = max(0, min(k, g.n - 1));
+    g.first.resize(g.n + 1);
+    g.heads.resize(static_cast<size_t>(g.n) * kk);
+    g.cost.resize(g.heads.size());
+
+    KdTree tree(coords);
+    vector<int> nb;
+    vector<int32_t> d(kk);
+    for (int i = 0; i < g.n; ++i){
+        g.first[i] = i * kk;
+        tree.nearest(i, kk, nb);
+        distanceRow(coords, i, nb.data(), kk, d.data()); // couts TSPLIB entiers
+        for (int t = 0; t < kk; ++t){
+            g.heads[g.first[i] + t] = nb[t];
+            g.cost[g.first[i] + t] = d[t];
+        }
+    }
+    g.first[g.n] = g.n * kk;
+    sortRows(g);
+    return g;
+}
+
+template <typename Matrix>
+static CandidateGraph nearestNeighborGraphT(const Matrix &D, int n, int k){
+    CandidateGraph g;
+    g.n = n;
+    int kk = max(0, min(k, n - 1));
+    g.first.resize(n + 1);
+    g.heads.resize(static_cast<size_t>(n) * kk);
+    g.cost.resize(g.heads.size());
+
+    vector<int> order;
+    for (int i = 0; i < n; ++i){
+        order.clear();
+        for (int j = 0; j < n; ++j)
+            {if (j != i) order.push_back(j);}
+        partial_sort(order.begin(), order.begin() + kk, order.end(),
+                     [&](int a, int b) { return D(i, a) < D(i, b) || (D(i, a) == D(i, b) && a < b); });
+        g.first[i] = i * kk;
+        for (int t = 0; t < kk; ++t){
+            g.heads[g.first[i] + t] = order[t];
+            g.cost[g.first[i] + t] = D(i, order[t]);
+        }
+    }
+    g.first[n] = n * kk;
+    return g;
+}
+
+CandidateGraph nearestNeighborGraph(const ATSPDataC &data, int k){
+    if (!data.coords.empty())
+        {return nearestNeighborGraph(data.coords, k);}
+    return data.visit([&](const auto &D) { return nearestNeighborGraphT(D, data.size, k); });
+}
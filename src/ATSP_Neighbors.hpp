@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include "ATSP_Data.hpp"
+
+using namespace std;
+
+// ======================================================================
+// ============== VOISINS (k-d tree + graphe de candidats CSR) ==========
+// ======================================================================
+
+// graphe de candidats compresse par lignes : voisins de i == heads[first[i] .. first[i + 1])
+// tries par cout croissant (puis indice)
+struct CandidateGraph{
+    int n = 0;
+    vector<int> first;      // n + 1
+    vector<int> heads;
+    vector<long long> cost; // cost[e] == d(i, heads[e])
+
+    int degree(int i) const { return first[i + 1] - first[i]; }
+    const int *begin(int i) const { return heads.data() + first[i]; }
+    const int *end(int i) const { return heads.data() + first[i + 1]; }
+    long long arcs() const { return static_cast<long long>(heads.size()); }
+};
+
+// k-d tree sur les coordonnees (construction O(n log n), requete ~O(log n + k))
+// GEO : points 3D sur la sphere (corde croissante avec la distance TSPLIB) ; MAN_2D / MAX_2D : normes L1 / Linf
+class KdTree{
+public:
+    explicit KdTree(const NodeCoords &coords);
+
+    // k plus proches voisins de i (i exclu), ordre quelconque
+    void nearest(int i, int k, vector<int> &out) const;
+
+private:
+    static const int LEAF = 8;
+
+    CoordMetric metric;
+    int dim; // 2 ou 3
+    vector<array<double, 3>> pts;
+    vector<int> idx;              // permutation des sommets (ordre de l'arbre)
+    vector<unsigned char> split;  // dimension de coupe du noeud de milieu mid (indexe par mid)
+
+    void build(int lo, int hi);
+    double pointDist(const array<double, 3> &a, const array<double, 3> &b) const;
+    double axisBound(double diff) const; // minore pointDist pour un ecart diff sur 1 axe
+
+    struct Query;
+    void search(Query &q, int lo, int hi) const;
+};
+
+// k plus proches voisins sortants de chaque sommet :
+//   coordonnees => k-d tree (sans matrice, LoadMode::Coords suffit)
+//   EXPLICIT    => tri partiel de chaque ligne de la matrice (O(n^2))
+CandidateGraph nearestNeighborGraph(const ATSPDataC &data, int k);
+CandidateGraph nearestNeighborGraph(const NodeCoords &coords, int k);
@@ -0,0 +1,27 @@
+#pragma once
+
+// parametres Gurobi communs aux solveurs (ligne de commande)
+struct SolverParams{
+    int threads = 1;          // GRB_IntParam_Threads (0 == choix Gurobi)
+    double timeLimit = 180.0; // secondes (CUT_LP : budget total de la boucle de coupes)
+
+    // coupes sous tour posees a la construction (ATSP CUT entier, attribut Lazy)
+    bool seedTwoCycles = false; // x_ij + x_ji <= 1 pour tout i < j (Lazy == 3)
+    int seedTriangles = 0;      // k >= 2 => triangles {i,j,l}, j,l parmi les k plus proches de i (Lazy == 1)
+
+    // --mem-budget : > 0 => ATSP CUT restreint aux arcs candidats (k plus proches + tour NN)
+    int candidateK = 0;
+
+    // --arc-elim : ATSP CUT / CUT_LP / MTZ orientes sans les arcs de cout reduit > upper - borne (1-arborescence)
+    // + arcs candidats (candidateK > 0) classes par cout reduit
+    bool arcElim = false;
+
+    // CUT_HYBRID : gain relatif de borne par round sous lequel la boucle racine cale (--tail-off)
+    double tailOff = 0.001;
+
+    // --checkpoint : secondes entre 2 ecritures du point de reprise (ATSP CUT / CUT_LP / CUT_HYBRID)
+    double checkpointEvery = 60.0;
+
+    // n <= heldKarpMax => Held-Karp exact sans Gurobi, quel que soit le mode (0 == jamais)
+    int heldKarpMax = 20;
+};
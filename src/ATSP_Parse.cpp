@@ -0,0 +1,65 @@
+#include "ATSP_Parse.hpp"
+#include <algorithm>
+
+using namespace std;
+
+vector<char> readRemaining(ifstream &inf){
+    vector<char> buf;
+    streampos here = inf.tellg();
+    inf.seekg(0, ios::end);
+    streampos last = inf.tellg();
+    if (here < 0 || last < here){
+        inf.clear();
+        return buf;
+    }
+    inf.seekg(here);
+    buf.resize(static_cast<size_t>(last - here));
+    inf.read(buf.data(), static_cast<streamsize>(buf.size()));
+    buf.resize(static_cast<size_t>(inf.gcount()));
+    return buf;
+}
+
+int parseThreads(size_t bytes){
+    const size_t MIN_BYTES = 1 << 20;
+    int hw = max(1, static_cast<int>(thread::hardware_concurrency()));
+    return static_cast<int>(min<size_t>(hw, max<size_t>(1, bytes / MIN_BYTES)));
+}
+
+static long long countTokens(const char *p, const char *end){
+    long long count = 0;
+    bool inWord = false;
+    for (; p < end; ++p){
+        bool blank = isBlank(*p);
+        count += (!blank && !inWord);
+        inWord = !blank;
+    }
+    return count;
+}
+
+vector<TokenChunk> splitTokenChunks(const char *begin, const char *end, int parts, long long &total){
+    vector<TokenChunk> chunks;
+    size_t bytes = static_cast<size_t>(end - begin);
+    parts = max(1, parts);
+
+    // coupe avancee jusqu'au 1er blanc => aucun mot partage entre 2 blocs
+    const char *cur = begin;
+    for (int k = 1; k <= parts && cur < end; ++k){
+        const char *cut = (k == parts) ? end : begin + bytes * k / parts;
+        cut = max(cut, cur);
+        while (cut < end && !isBlank(*cut))
+            {++cut;}
+        if (cut > cur)
+            {chunks.push_back({cur, cut, 0});}
+        cur = cut;
+    }
+
+    vector<long long> counts(chunks.size(), 0);
+    forEachChunk(chunks, [&](size_t k, const TokenChunk &c) { counts[k] = countTokens(c.begin, c.end); });
+
+    total = 0;
+    for (size_t k = 0; k < chunks.size(); ++k){
+        chunks[k].first = total;
+        total += counts[k];
+    }
+    return chunks;
+}
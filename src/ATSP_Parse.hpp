@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// ======================================================================
+// ============== LECTURE RAPIDE (sections de nombres entiers) ==========
+// ======================================================================
+// fichier en memoire, decoupe en blocs aux frontieres de mots, blocs lus en parallele
+
+// bloc [begin, end) du tampon ; first == rang (dans la section) de son 1er nombre
+struct TokenChunk{
+    const char *begin;
+    const char *end;
+    long long first;
+};
+
+// reste du flux (depuis la position courante) en memoire
+vector<char> readRemaining(ifstream &inf);
+
+// nb de threads pour bytes octets (>= 1 Mo par thread, 1 seul pour les petits fichiers)
+int parseThreads(size_t bytes);
+
+// decoupe [begin, end) en <= parts blocs (coupes sur un blanc), compte les mots de chaque bloc en parallele
+// total == nb de mots du tampon
+vector<TokenChunk> splitTokenChunks(const char *begin, const char *end, int parts, long long &total);
+
+// f(k, chunks[k]) pour chaque bloc, 1 thread par bloc (inline si 1 seul bloc)
+template <typename F>
+void forEachChunk(const vector<TokenChunk> &chunks, F f){
+    if (chunks.size() <= 1){
+        for (size_t k = 0; k < chunks.size(); ++k)
+            {f(k, chunks[k]);}
+        return;
+    }
+    vector<thread> workers;
+    workers.reserve(chunks.size());
+    for (size_t k = 0; k < chunks.size(); ++k)
+        {workers.emplace_back([&f, &chunks, k]() { f(k, chunks[k]); });}
+    for (thread &t : workers)
+        {t.join();}
+}
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; }
+
+// entier signe suivant (blancs sautes) ; false si fin du tampon ou mot non entier
+inline bool parseInteger(const char *&p, const char *end, long long &v){
+    while (p < end && isBlank(*p))
+        {++p;}
+    if (p == end)
+        {return false;}
+
+    bool neg = (*p == '-');
+    if (*p == '-' || *p == '+')
+        {++p;}
+    if (p == end || *p < '0' || *p > '9')
+        {return false;}
+
+    unsigned long long u = 0;
+    while (p < end && *p >= '0' && *p <= '9'){
+        if (u > 922337203685477579ULL)
+            {return false;} // hors long long
+        u = u * 10 + static_cast<unsigned>(*p - '0');
+        ++p;
+    }
+    if (p < end && !isBlank(*p))
+        {return false;} // "1.5", "12abc" ...
+    v = neg ? -static_cast<long long>(u) : static_cast<long long>(u);
+    return true;
+}
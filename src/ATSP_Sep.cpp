@@ -0,0 +1,797 @@
+#include "ATSP_Sep.hpp"
+#include "ATSP_MaxFlow.hpp"
+#include <sstream>
+#include <queue>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+
+// Point == vector<vector<double>> ou FlatPoint (sol[i][j])
+template <typename Point>
+static bool findSubtour(const Point &sol, vector<int> &S){
+// ================= QUESTION 2 =================
+// * detecte sous tour dans solution int
+// * retourne S si contrainte (11) violee
+
+    int n = static_cast<int>(sol.size());
+    vector<bool> visited(n, false);
+    
+    // pour chaque sommet non visite
+    for (int start = 0; start < n; ++start){
+        if (visited[start]) // si le sommet est visité alrs skip le sommet
+            {continue;}
+
+        vector<int> cycle;
+        int current = start;
+
+        // suit arcs x[i][j] > 0.5 ; 0.5 car ~1 => choisi, tolerance numérique since it's double 1.9 is ~2 than 1  
+        while (!visited[current]){
+            visited[current] = true;
+            cycle.push_back(current);
+
+            bool foundNext = false;
+
+            for (int j = 0; j < n; ++j){
+                if (current != j && sol[current][j] > 0.5){
+                    current = j;
+                    foundNext = true;
+                    break;
+                }
+            }
+
+            if (!foundNext)
+                {break;}
+        }
+
+        // si cycle ferme && taille < n        
+        if (current == start && cycle.size() < n){
+            S = cycle; // sous tour trouve !!
+            return true;
+        }
+    }
+
+    S.clear(); // pas sous tour && sanitize
+    return false;
+}
+
+bool findSubtour_S(const vector<vector<double>> &sol, vector<int> &S) { return findSubtour(sol, S); }
+bool findSubtour_S(const FlatPoint &sol, vector<int> &S) { return findSubtour(sol, S); }
+
+template <typename Point>
+static bool tourOf(const Point &sol, vector<int> &tour){
+    int n = static_cast<int>(sol.size());
+    vector<char> seen(n, 0);
+    tour.clear();
+    for (int v = 0; static_cast<int>(tour.size()) < n; ){
+        tour.push_back(v);
+        seen[v] = 1;
+        int next = -1;
+        for (int j = 0; j < n && next < 0; ++j){
+            if (j != v && sol[v][j] > 0.5)
+                {next = j;}
+        }
+        if (next < 0 || (next == 0) != (static_cast<int>(tour.size()) == n) || (next != 0 && seen[next])){
+            tour.clear();
+            return false; // retour en 0 trop tot / trop tard
+        }
+        v = next;
+    }
+    return n > 0;
+}
+
+bool tourFromSolution(const vector<vector<double>> &sol, vector<int> &tour) { return tourOf(sol, tour); }
+bool tourFromSolution(const FlatPoint &sol, vector<int> &tour) { return tourOf(sol, tour); }
+
+// balayage 0 -> tous les puits (Flow == PushRelabel ou WarmMinCut)
+template <typename Flow>
+static bool fractionalCutSweep(Flow &flow, const vector<vector<double>> &sol, vector<int> &S, SolveStats *stats, double *violation){
+    int n = static_cast<int>(sol.size());
+
+    // graphe support (arcs sol > EPS) construit 1 fois, reutilise pour tous les puits
+    {
+        ScopedTimer mfTimer(stats ? &stats->maxflowNs : nullptr, stats);
+        flow.build(sol);
+    }
+
+    // pour chaque sink != 0
+    for (int sink = 1; sink < n; ++sink){
+        double val = 0.0;
+
+        // calcule min cut 0 -> sink
+        {
+            ScopedTimer mfTimer(stats ? &stats->maxflowNs : nullptr, stats);
+            val = flow.minCut(0, sink);
+        }
+        if (stats)
+            {stats->add(stats->maxflowCalls, 1);}
+
+        // si val < 1 => violation
+        if (val < 1.0 - 1e-6){ // 1e-6 => petite tolérance ; avoid the false-positive cases
+            S.clear(); // sanitizing
+            S.reserve(n); // sanitizing
+
+            // construit S (cote puits)
+            for (int v = 0; v < n; ++v)
+               { if (flow.inSinkSide(v))
+                    {S.push_back(v);}
+                }
+
+            // si trivial => sink suivant
+            if (S.empty() || static_cast<int>(S.size()) == n)
+                {continue;}
+
+            if (violation)
+                {*violation = 1.0 - val;}
+            return true; // coupe trouve
+        }
+    }
+
+    S.clear(); // pas de coupe
+    return false;
+}
+
+bool findFractionalCut_S(const vector<vector<double>> &sol, vector<int> &S, SolveStats *stats, double *violation,
+                         WarmMinCut *warm){
+    if (warm)
+        {return fractionalCutSweep(*warm, sol, S, stats, violation);}
+    PushRelabel flow;
+    return fractionalCutSweep(flow, sol, S, stats, violation);
+}
+
+// ================= CAS SYMETRIQUE =================
+// sol[i][j] == sol[j][i] == x_e ; contrainte sous tour : x(delta(S)) >= 2
+
+template <typename Point>
+static vector<vector<int>> components(const Point &sol, double threshold){
+    int n = static_cast<int>(sol.size());
+    vector<int> comp(n, -1);
+    vector<vector<int>> comps;
+    vector<int> stack;
+
+    for (int start = 0; start < n; ++start){
+        if (comp[start] >= 0)
+            {continue;}
+
+        int c = static_cast<int>(comps.size());
+        comps.push_back(vector<int>());
+        comp[start] = c;
+        stack.push_back(start);
+
+        // parcours en profondeur sur le support x_e > threshold
+        while (!stack.empty()){
+            int u = stack.back();
+            stack.pop_back();
+            comps[c].push_back(u);
+            for (int v = 0; v < n; ++v){
+                if (v != u && comp[v] < 0 && sol[u][v] > threshold){
+                    comp[v] = c;
+                    stack.push_back(v);
+                }
+            }
+        }
+    }
+    return comps;
+}
+
+// plus petite composante (== sous tour le plus court)
+static bool smallestComponent(const vector<vector<int>> &comps, vector<int> &S){
+    if (comps.size() <= 1){
+        S.clear();
+        return false;
+    }
+    size_t best = 0;
+    for (size_t c = 1; c < comps.size(); ++c)
+        {if (comps[c].size() < comps[best].size()) best = c;}
+    S = comps[best];
+    return true;
+}
+
+vector<vector<int>> findComponents(const vector<vector<double>> &sol, double threshold){
+    return components(sol, threshold);
+}
+
+vector<vector<int>> findComponents(const FlatPoint &sol, double threshold) { return components(sol, threshold); }
+
+bool findSymSubtour_S(const vector<vector<double>> &sol, vector<int> &S){
+    return smallestComponent(findComponents(sol, 0.5), S);
+}
+
+double stoerWagnerMinCut(int n, const vector<vector<pair<int, double>>> &adj0, vector<int> &S){
+    S.clear();
+    if (n < 2)
+        {return 0.0;}
+
+    // listes d'adjacence modifiees par les fusions (sommet "last" absorbe dans "prev")
+    vector<vector<pair<int, double>>> adj = adj0;
+    vector<vector<int>> members(n);
+    for (int v = 0; v < n; ++v)
+        {members[v].push_back(v);}
+
+    vector<char> active(n, 1), inA(n, 0);
+    vector<double> key(n, 0.0);
+    vector<int> pos(n, -1);
+    double best = numeric_limits<double>::infinity();
+
+    for (int nbActive = n; nbActive > 1; --nbActive){
+        // phase : ordre d'adjacence maximale (tas avec entrees perimees ignorees)
+        int start = -1;
+        for (int v = 0; v < n; ++v){
+            if (active[v]){
+                key[v] = 0.0;
+                inA[v] = 0;
+                if (start < 0)
+                    {start = v;}
+            }
+        }
+
+        priority_queue<pair<double, int>> heap;
+        heap.push(make_pair(0.0, start));
+        int prev = -1, last = -1;
+
+        for (int added = 0; added < nbActive; ++added){
+            int u = -1;
+            while (!heap.empty()){
+                pair<double, int> top = heap.top();
+                heap.pop();
+                if (!inA[top.second] && top.first == key[top.second]){
+                    u = top.second;
+                    break;
+                }
+            }
+            if (u < 0){ // support deconnecte : sommet actif suivant
+                for (int v = 0; v < n && u < 0; ++v)
+                    {if (active[v] && !inA[v]) u = v;}
+            }
+
+            inA[u] = 1;
+            prev = last;
+            last = u;
+            for (const pair<int, double> &e : adj[u]){
+                if (active[e.first] && !inA[e.first]){
+                    key[e.first] += e.second;
+                    heap.push(make_pair(key[e.first], e.first));
+                }
+            }
+        }
+
+        // coupe de la phase == {last} contre le reste
+        if (key[last] < best){
+            best = key[last];
+            S = members[last];
+        }
+
+        // fusion last -> prev
+        members[prev].insert(members[prev].end(), members[last].begin(), members[last].end());
+        for (size_t k = 0; k < adj[prev].size(); ++k)
+            {pos[adj[prev][k].first] = static_cast<int>(k);}
+
+        for (const pair<int, double> &e : adj[last]){
+            int v = e.first;
+            if (v == prev)
+                {continue;}
+
+            if (pos[v] >= 0)
+                {adj[prev][pos[v]].second += e.second;}
+            else{
+                pos[v] = static_cast<int>(adj[prev].size());
+                adj[prev].push_back(e);
+            }
+
+            // cote v : arete vers last redirigee / cumulee sur prev
+            int iLast = -1, iPrev = -1;
+            for (size_t k = 0; k < adj[v].size(); ++k){
+                if (adj[v][k].first == last) iLast = static_cast<int>(k);
+                else if (adj[v][k].first == prev) iPrev = static_cast<int>(k);
+            }
+            if (iPrev >= 0){
+                adj[v][iPrev].second += adj[v][iLast].second;
+                adj[v][iLast] = adj[v].back();
+                adj[v].pop_back();
+            }
+            else
+                {adj[v][iLast].first = prev;}
+        }
+
+        // retire l'arete prev - last
+        for (size_t k = 0; k < adj[prev].size(); ++k){
+            pos[adj[prev][k].first] = -1;
+            if (adj[prev][k].first == last){
+                adj[prev][k] = adj[prev].back();
+                adj[prev].pop_back();
+                --k;
+            }
+        }
+        pos[last] = -1;
+
+        active[last] = 0;
+        adj[last].clear();
+        members[last].clear();
+    }
+
+    return best;
+}
+
+template <typename Point>
+static bool symFractionalCut(const Point &sol, vector<int> &S, SolveStats *stats, double *violation){
+    int n = static_cast<int>(sol.size());
+    const double EPS_SUPPORT = 1e-9;
+
+    // support deconnecte => coupe de valeur 0 (pas besoin de coupe min)
+    if (smallestComponent(components(sol, EPS_SUPPORT), S)){
+        if (violation)
+            {*violation = 2.0;}
+        return true;
+    }
+
+    vector<vector<pair<int, double>>> adj(n);
+    for (int i = 0; i < n; ++i){
+        for (int j = i + 1; j < n; ++j){
+            if (sol[i][j] > EPS_SUPPORT){
+                adj[i].push_back(make_pair(j, sol[i][j]));
+                adj[j].push_back(make_pair(i, sol[i][j]));
+            }
+        }
+    }
+
+    double val = 0.0;
+    {
+        ScopedTimer mfTimer(stats ? &stats->maxflowNs : nullptr, stats); // noyau de coupe min
+        val = stoerWagnerMinCut(n, adj, S);
+    }
+    if (stats)
+        {stats->add(stats->maxflowCalls, 1);}
+
+    if (val < 2.0 - 1e-6 && !S.empty() && static_cast<int>(S.size()) < n){
+        if (violation)
+            {*violation = 2.0 - val;}
+        return true;
+    }
+
+    S.clear(); // pas de coupe
+    return false;
+}
+
+bool findSymFractionalCut_S(const vector<vector<double>> &sol, vector<int> &S, SolveStats *stats, double *violation){
+    return symFractionalCut(sol, S, stats, violation);
+}
+
+bool findSymFractionalCut_S(const FlatPoint &sol, vector<int> &S, SolveStats *stats, double *violation){
+    return symFractionalCut(sol, S, stats, violation);
+}
+
+// ================= PEIGNES / BLOSSOMS (symetrique) =================
+
+// sum_{i<j in V} x_ij
+template <typename Point>
+static double innerSum(const Point &sol, const vector<int> &V){
+    double s = 0.0;
+    for (size_t a = 0; a < V.size(); ++a)
+        {for (size_t b = a + 1; b < V.size(); ++b)
+            {s += sol[V[a]][V[b]];}}
+    return s;
+}
+
+template <typename Point>
+static double combViolation(const Point &sol, const Comb &comb){
+    double lhs = innerSum(sol, comb.handle);
+    for (const vector<int> &T : comb.teeth)
+        {lhs += innerSum(sol, T);}
+    return lhs - comb.rhs();
+}
+
+template <typename Point>
+static int combsOf(const Point &sol, vector<Comb> &combs, int maxCombs){
+    const double EPS = 1e-6;
+    int n = static_cast<int>(sol.size());
+    combs.clear();
+
+    // composantes du graphe fractionnaire {e : EPS < x_e < 1 - EPS}
+    vector<int> comp(n, -1);
+    vector<vector<int>> handles;
+    for (int start = 0; start < n; ++start){
+        if (comp[start] >= 0)
+            {continue;}
+        vector<int> H, stack(1, start);
+        comp[start] = static_cast<int>(handles.size());
+        while (!stack.empty()){
+            int u = stack.back();
+            stack.pop_back();
+            H.push_back(u);
+            for (int v = 0; v < n; ++v){
+                if (v != u && comp[v] < 0 && sol[u][v] > EPS && sol[u][v] < 1.0 - EPS){
+                    comp[v] = comp[start];
+                    stack.push_back(v);
+                }
+            }
+        }
+        handles.push_back(H);
+    }
+
+    vector<char> inH(n, 0), used(n, 0);
+    for (vector<int> H : handles){
+        if (H.size() < 3)
+            {continue;} // pas d'arete fractionnaire a l'interieur
+
+        // dents == 1-aretes de delta(H) ; 2 dents sur le meme sommet w exterieur => w entre dans H
+        vector<pair<int, int>> teeth;
+        bool changed = true;
+        while (changed){
+            changed = false;
+            fill(inH.begin(), inH.end(), 0);
+            for (int v : H)
+                {inH[v] = 1;}
+
+            teeth.clear();
+            vector<int> hits(n, 0);
+            for (int u : H){
+                for (int v = 0; v < n; ++v){
+                    if (!inH[v] && v != u && sol[u][v] >= 1.0 - EPS){
+                        teeth.push_back(make_pair(u, v));
+                        hits[v]++;
+                    }
+                }
+            }
+            for (int v = 0; v < n; ++v){
+                if (hits[v] >= 2){
+                    H.push_back(v);
+                    changed = true;
+                }
+            }
+        }
+
+        int k = static_cast<int>(teeth.size());
+        if (k < 3 || k % 2 == 0)
+            {continue;}
+
+        // blossom : dents == aretes
+        Comb blossom;
+        blossom.handle = H;
+        for (const pair<int, int> &t : teeth)
+            {blossom.teeth.push_back(vector<int>{t.first, t.second});}
+        blossom.violation = combViolation(sol, blossom);
+
+        // peigne simple : dents prolongees le long des 1-chemins hors de H
+        Comb comb = blossom;
+        fill(used.begin(), used.end(), 0);
+        for (const vector<int> &T : comb.teeth)
+            {used[T[1]] = 1;}
+        for (vector<int> &T : comb.teeth){
+            int prev = T[0], cur = T[1];
+            while (true){
+                int next = -1;
+                for (int w = 0; w < n && next < 0; ++w){
+                    if (w != prev && w != cur && !inH[w] && !used[w] && sol[cur][w] >= 1.0 - EPS)
+                        {next = w;}
+                }
+                if (next < 0)
+                    {break;}
+                used[next] = 1;
+                T.push_back(next);
+                prev = cur;
+                cur = next;
+            }
+        }
+        comb.violation = combViolation(sol, comb);
+
+        const Comb &best = (comb.violation > blossom.violation + EPS) ? comb : blossom;
+        if (best.violation > EPS)
+            {combs.push_back(best);}
+    }
+
+    sort(combs.begin(), combs.end(), [](const Comb &a, const Comb &b) { return a.violation > b.violation; });
+    if (static_cast<int>(combs.size()) > maxCombs)
+        {combs.resize(maxCombs);}
+    return static_cast<int>(combs.size());
+}
+
+int findCombs(const vector<vector<double>> &sol, vector<Comb> &combs, int maxCombs){
+    return combsOf(sol, combs, maxCombs);
+}
+
+int findCombs(const FlatPoint &sol, vector<Comb> &combs, int maxCombs) { return combsOf(sol, combs, maxCombs); }
+
+// ================= FORME CREUSE DES COUPES SOUS TOUR =================
+
+void sparsestSubtourRow(int n, const vector<int> &S, bool symmetric, CutRow &row){
+    vector<char> inS;
+    sparsestSubtourRow(n, S, symmetric, row, inS);
+}
+
+void sparsestSubtourRow(int n, const vector<int> &S, bool symmetric, CutRow &row, vector<char> &inS){
+    int k = static_cast<int>(S.size());
+    row.tails.clear();
+    row.heads.clear();
+
+    inS.assign(n, 0);
+    for (int v : S)
+        {inS[v] = 1;}
+
+    // nnz de chaque forme (coupe, interieur S, interieur V\S)
+    long long cross = static_cast<long long>(k) * (n - k);
+    long long inner = static_cast<long long>(k) * (k - 1);
+    long long outer = static_cast<long long>(n - k) * (n - k - 1);
+    if (symmetric){
+        inner /= 2;
+        outer /= 2;
+    }
+
+    if (cross <= inner && cross <= outer){
+        row.tails.reserve(cross);
+        row.heads.reserve(cross);
+        // oriente : arcs entrants dans S ; symetrique : aretes de delta(S)
+        for (int i = 0; i < n; ++i){
+            if (inS[i])
+                {continue;}
+            for (int j : S){
+                row.tails.push_back(symmetric ? min(i, j) : i);
+                row.heads.push_back(symmetric ? max(i, j) : j);
+            }
+        }
+        row.sense = '>';
+        row.rhs = symmetric ? 2.0 : 1.0;
+        return;
+    }
+
+    // arcs / aretes internes du plus petit cote
+    char side = (inner <= outer) ? 1 : 0;
+    long long nnz = (inner <= outer) ? inner : outer;
+    row.tails.reserve(nnz);
+    row.heads.reserve(nnz);
+    for (int i = 0; i < n; ++i){
+        if (inS[i] != side)
+            {continue;}
+        for (int j = symmetric ? i + 1 : 0; j < n; ++j){
+            if (j != i && inS[j] == side){
+                row.tails.push_back(i);
+                row.heads.push_back(j);
+            }
+        }
+    }
+    row.sense = '<';
+    row.rhs = (side ? k : n - k) - 1.0;
+}
+
+template <typename Point>
+static double violationOf(const Point &sol, const CutRow &row){
+    double lhs = 0.0;
+    for (int t = 0; t < row.nnz(); ++t)
+        {lhs += sol[row.tails[t]][row.heads[t]];}
+    return (row.sense == '<') ? lhs - row.rhs : row.rhs - lhs;
+}
+
+double rowViolation(const vector<vector<double>> &sol, const CutRow &row) { return violationOf(sol, row); }
+double rowViolation(const FlatPoint &sol, const CutRow &row) { return violationOf(sol, row); }
+
+// ================= D_k+ / D_k- (ATSP) =================
+
+void liftedCycleTerms(const LiftedCycle &cut, vector<int> &tails, vector<int> &heads, vector<double> &coefs){
+    const vector<int> &s = cut.seq; // s[h-1] == i_h
+    int k = static_cast<int>(s.size());
+    tails.clear();
+    heads.clear();
+    coefs.clear();
+
+    auto add = [&](int i, int j, double c){
+        for (size_t t = 0; t < tails.size(); ++t){
+            if (tails[t] == i && heads[t] == j){
+                coefs[t] += c;
+                return;
+            }
+        }
+        tails.push_back(i);
+        heads.push_back(j);
+        coefs.push_back(c);
+    };
+
+    // cycle i_1 -> .. -> i_k -> i_1
+    for (int h = 0; h < k; ++h)
+        {add(s[h], s[(h + 1) % k], 1.0);}
+
+    if (cut.plus){
+        for (int h = 2; h <= k - 1; ++h)
+            {add(s[h - 1], s[0], 2.0);}
+        for (int h = 3; h <= k - 1; ++h)
+            {for (int l = 2; l < h; ++l)
+                {add(s[h - 1], s[l - 1], 1.0);}}
+    }
+    else{
+        for (int h = 3; h <= k; ++h)
+            {add(s[0], s[h - 1], 2.0);}
+        for (int h = 4; h <= k; ++h)
+            {for (int l = 3; l < h; ++l)
+                {add(s[h - 1], s[l - 1], 1.0);}}
+    }
+}
+
+template <typename Point>
+static double liftedCycleLhs(const Point &sol, const LiftedCycle &cut, LiftedScratch &w){
+    liftedCycleTerms(cut, w.tails, w.heads, w.coefs);
+    double lhs = 0.0;
+    for (size_t t = 0; t < w.tails.size(); ++t)
+        {lhs += w.coefs[t] * sol[w.tails[t]][w.heads[t]];}
+    return lhs;
+}
+
+template <typename Point>
+static int liftedCycles(const Point &sol, vector<LiftedCycle> &cuts, LiftedScratch &w, int maxLen, int maxCuts){
+    const double EPS = 1e-6;
+    int n = static_cast<int>(sol.size());
+    cuts.clear();
+    if (n < 3)
+        {return 0;}
+    maxLen = min(maxLen, n - 1); // k == n => contrainte de degre, jamais violee
+
+    vector<char> &inSeq = w.inSeq;
+    vector<int> &seq = w.seq;
+    for (int first = 0; first < n; ++first){
+        for (int fam = 0; fam < 2; ++fam){
+            bool plus = (fam == 0);
+            seq.assign(1, first);
+            inSeq.assign(n, 0);
+            inSeq[first] = 1;
+
+            double lhs = 0.0; // lhs de la sequence courante (arc de fermeture compris)
+            double bestViol = EPS;
+            int bestLen = 0;
+
+            while (static_cast<int>(seq.size()) < maxLen){
+                int h = static_cast<int>(seq.size()); // i_h == seq.back()
+                int last = seq.back();
+
+                // gain de i_{h+1} == v : arc (i_h,v) + fermeture (v,i_1) - ancienne fermeture (i_h,i_1)
+                int bestV = -1;
+                double bestGain = -1.0;
+                for (int v = 0; v < n; ++v){
+                    if (inSeq[v])
+                        {continue;}
+                    double gain = sol[last][v] + sol[v][first];
+                    if (!plus){
+                        if (h >= 2)
+                            {gain += 2.0 * sol[first][v];}
+                        for (int l = 3; l <= h; ++l)
+                            {gain += sol[v][seq[l - 1]];}
+                    }
+                    if (gain > bestGain){
+                        bestGain = gain;
+                        bestV = v;
+                    }
+                }
+                if (bestV < 0 || bestGain <= EPS)
+                    {break;}
+
+                // termes ne dependant que de i_h (D+) : 2 x(i_h,i_1) + x(i_h,i_l), 2 <= l < h
+                double fixed = -sol[last][first];
+                if (plus && h >= 2){
+                    fixed += 2.0 * sol[last][first];
+                    for (int l = 2; l < h; ++l)
+                        {fixed += sol[last][seq[l - 1]];}
+                }
+
+                lhs += bestGain + fixed;
+                seq.push_back(bestV);
+                inSeq[bestV] = 1;
+
+                int k = static_cast<int>(seq.size());
+                if (k >= 3 && lhs - (k - 1) > bestViol){
+                    bestViol = lhs - (k - 1);
+                    bestLen = k;
+                }
+            }
+
+            if (bestLen == 0)
+                {continue;}
+
+            LiftedCycle &cut = w.cand;
+            cut.seq.assign(seq.begin(), seq.begin() + bestLen);
+            cut.plus = plus;
+            cut.violation = liftedCycleLhs(sol, cut, w) - cut.rhs(); // recalcule (prefixe)
+            if (cut.violation <= EPS)
+                {continue;}
+
+            // meme sequence et meme famille => doublon
+            bool dup = false;
+            for (const LiftedCycle &c : cuts){
+                if (c.plus == cut.plus && c.seq == cut.seq)
+                    {dup = true; break;}
+            }
+            if (!dup)
+                {cuts.push_back(cut);}
+        }
+    }
+
+    sort(cuts.begin(), cuts.end(), [](const LiftedCycle &a, const LiftedCycle &b) { return a.violation > b.violation; });
+    if (static_cast<int>(cuts.size()) > maxCuts)
+        {cuts.resize(maxCuts);}
+    return static_cast<int>(cuts.size());
+}
+
+int findLiftedCycles(const vector<vector<double>> &sol, vector<LiftedCycle> &cuts, int maxLen, int maxCuts){
+    LiftedScratch w;
+    return liftedCycles(sol, cuts, w, maxLen, maxCuts);
+}
+
+int findLiftedCycles(const FlatPoint &sol, vector<LiftedCycle> &cuts, LiftedScratch &scratch, int maxLen, int maxCuts){
+    return liftedCycles(sol, cuts, scratch, maxLen, maxCuts);
+}
+
+// ================= MTZ PARESSEUX =================
+
+template <typename Point>
+static int mtzViolations(const Point &sol, const vector<double> &u, vector<MTZCut> &cuts, int maxCuts){
+    const double EPS = 1e-6;
+    int n = static_cast<int>(sol.size());
+    cuts.clear();
+
+    for (int i = 1; i < n; ++i){
+        for (int j = 1; j < n; ++j){
+            // x_ij == 0 => u_j >= u_i - (n-2) toujours vrai (1 <= u <= n-1)
+            if (i == j || sol[i][j] <= EPS)
+                {continue;}
+            double viol = u[i] + 1.0 - (n - 1) * (1.0 - sol[i][j]) - u[j];
+            if (viol > EPS)
+                {cuts.push_back(MTZCut{i, j, viol});}
+        }
+    }
+
+    if (static_cast<int>(cuts.size()) > maxCuts){
+        partial_sort(cuts.begin(), cuts.begin() + maxCuts, cuts.end(),
+                     [](const MTZCut &a, const MTZCut &b) { return a.violation > b.violation; });
+        cuts.resize(maxCuts);
+    }
+    else{
+        sort(cuts.begin(), cuts.end(), [](const MTZCut &a, const MTZCut &b) { return a.violation > b.violation; });
+    }
+    return static_cast<int>(cuts.size());
+}
+
+int findMTZViolations(const vector<vector<double>> &sol, const vector<double> &u, vector<MTZCut> &cuts, int maxCuts){
+    return mtzViolations(sol, u, cuts, maxCuts);
+}
+
+int findMTZViolations(const FlatPoint &sol, const vector<double> &u, vector<MTZCut> &cuts, int maxCuts){
+    return mtzViolations(sol, u, cuts, maxCuts);
+}
+
+// ================= POINTS ENREGISTRES =================
+// format texte : "POINT n nnz" puis nnz lignes "i j x_ij" (x_ij > 0)
+
+void savePoint(ostream &out, const vector<vector<double>> &sol){
+    int n = static_cast<int>(sol.size());
+    int nnz = 0;
+    for (int i = 0; i < n; ++i)
+        {for (int j = 0; j < n; ++j)
+            {if (i != j && sol[i][j] > 1e-9) nnz++;}}
+
+    out << "POINT " << n << " " << nnz << "\n";
+    out.precision(17);
+    for (int i = 0; i < n; ++i){
+        for (int j = 0; j < n; ++j){
+            if (i != j && sol[i][j] > 1e-9)
+                {out << i << " " << j << " " << sol[i][j] << "\n";}
+        }
+    }
+}
+
+vector<vector<vector<double>>> loadPoints(istream &in){
+    vector<vector<vector<double>>> points;
+    string tag;
+    while (in >> tag){
+        if (tag != "POINT")
+            {break;} // fichier mal forme => stop
+
+        int n = 0, nnz = 0;
+        in >> n >> nnz;
+        vector<vector<double>> sol(n, vector<double>(n, 0.0));
+        for (int k = 0; k < nnz; ++k){
+            int i, j;
+            double v;
+            in >> i >> j >> v;
+            if (i >= 0 && i < n && j >= 0 && j < n)
+                {sol[i][j] = v;}
+        }
+        points.push_back(sol);
+    }
+    return points;
+}
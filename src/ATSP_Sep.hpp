@@ -0,0 +1,155 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include "ATSP_Stats.hpp"
+
+using namespace std;
+
+// ======================================================================
+// ============== SEPARATION (sans Gurobi => utilisable par TSP_bench) ==
+// ======================================================================
+
+// point n x n a plat (ligne i == [i n, (i + 1) n)) : sol[i][j] comme vector<vector<double>>, 1 seul buffer
+// (callback CUT : rempli a chaque MIPSOL / MIPNODE sans allocation)
+struct FlatPoint{
+    int n = 0;
+    vector<double> x;
+
+    void assign(int size){
+        n = size;
+        x.assign(static_cast<size_t>(n) * n, 0.0);
+    }
+    int size() const { return n; }
+    double *operator[](int i) { return x.data() + static_cast<size_t>(i) * n; }
+    const double *operator[](int i) const { return x.data() + static_cast<size_t>(i) * n; }
+};
+
+// detecte 1 sous tour dans sol => remplit S si trouve
+bool findSubtour_S(const std::vector<std::vector<double>> &sol, std::vector<int> &S);
+bool findSubtour_S(const FlatPoint &sol, vector<int> &S);
+
+// sol entiere == 1 tour => successeurs (x > 0.5) depuis 0 ; false sinon (sous tours, sommet sans successeur)
+bool tourFromSolution(const vector<vector<double>> &sol, vector<int> &tour);
+bool tourFromSolution(const FlatPoint &sol, vector<int> &tour);
+
+class WarmMinCut;
+
+// detecte 1 coupe violee via min cut => remplit S (+ violation 1 - val si demande)
+// warm != nullptr => flots repris du point precedent (ATSP_MaxFlow.hpp), meme resultat
+bool findFractionalCut_S(const vector<vector<double>> &sol, vector<int> &S,
+                         SolveStats *stats = nullptr, double *violation = nullptr, WarmMinCut *warm = nullptr);
+
+// ligne de coupe creuse : sum x[tails[k]][heads[k]] (sense) rhs, coefs == 1
+// sense == '<' ou '>' (== GRB_LESS_EQUAL / GRB_GREATER_EQUAL)
+struct CutRow{
+    vector<int> tails;
+    vector<int> heads;
+    char sense;
+    double rhs;
+
+    int nnz() const { return static_cast<int>(tails.size()); }
+};
+
+// coupe sous tour sur S sous la forme equivalente la plus creuse (degres == 1 ou 2) :
+//   oriente    : x(delta-(S)) >= 1  <=>  x(A(S)) <= |S| - 1  <=>  x(A(V\S)) <= n - |S| - 1
+//   symetrique : x(delta(S))  >= 2  <=>  x(E(S)) <= |S| - 1  <=>  x(E(V\S)) <= n - |S| - 1
+// symetrique => arcs (i,j) avec i < j seulement
+void sparsestSubtourRow(int n, const vector<int> &S, bool symmetric, CutRow &row);
+// idem, marquage de S dans inS (buffer reutilise par l'appelant : callbacks, boucle de coupes)
+void sparsestSubtourRow(int n, const vector<int> &S, bool symmetric, CutRow &row, vector<char> &inS);
+
+// lhs - rhs ('<') ou rhs - lhs ('>') en sol ; > 0 == violee
+// (symetrique, forme interieure : violation == (2 - x(delta(S))) / 2)
+double rowViolation(const vector<vector<double>> &sol, const CutRow &row);
+double rowViolation(const FlatPoint &sol, const CutRow &row);
+
+// ---------- cas symetrique (sol[i][j] == sol[j][i] == x_e) ----------
+
+// composantes connexes du support (x_e > seuil) ; > 1 composante => sous tours
+vector<vector<int>> findComponents(const vector<vector<double>> &sol, double threshold);
+vector<vector<int>> findComponents(const FlatPoint &sol, double threshold);
+
+// detecte 1 sous tour dans sol entiere => S == plus petite composante
+bool findSymSubtour_S(const vector<vector<double>> &sol, vector<int> &S);
+
+// coupe globale min (Stoer-Wagner) => S si x(delta(S)) < 2 (+ violation 2 - val)
+bool findSymFractionalCut_S(const vector<vector<double>> &sol, vector<int> &S,
+                            SolveStats *stats = nullptr, double *violation = nullptr);
+bool findSymFractionalCut_S(const FlatPoint &sol, vector<int> &S, SolveStats *stats = nullptr, double *violation = nullptr);
+
+// Stoer-Wagner sur graphe creux : renvoie la valeur de la coupe min, cote dans S
+double stoerWagnerMinCut(int n, const vector<vector<pair<int, double>>> &adj, vector<int> &S);
+
+// peigne : x(E(H)) + sum_i x(E(T_i)) <= |H| + sum_i (|T_i| - 1) - (k+1)/2, k impair >= 3
+// (dents == aretes => inegalite 2-matching / blossom)
+struct Comb{
+    vector<int> handle;       // H
+    vector<vector<int>> teeth; // T_1..T_k (disjointes, T_i inter H != vide, T_i \ H != vide)
+    double violation;         // lhs - rhs en sol
+
+    double rhs() const{
+        double r = static_cast<double>(handle.size());
+        for (const vector<int> &T : teeth)
+            {r += static_cast<double>(T.size()) - 1.0;}
+        return r - (teeth.size() + 1) / 2.0;
+    }
+};
+
+// heuristique composantes impaires (Padberg-Hong) sur le support fractionnaire :
+// poignees == composantes de {e : 0 < x_e < 1}, dents == 1-aretes (ou 1-chemins) sortantes
+// => combs violes tries par violation decroissante (au plus maxCombs)
+int findCombs(const vector<vector<double>> &sol, vector<Comb> &combs, int maxCombs = 10);
+int findCombs(const FlatPoint &sol, vector<Comb> &combs, int maxCombs = 10);
+
+// ---------- cas asymetrique : inegalites D_k+ / D_k- (Grotschel-Padberg) ----------
+// sequence (i_1..i_k), k >= 3 : cycle i_1 -> .. -> i_k -> i_1 + arcs releves <= k - 1
+// D+ : + 2 x(i_h,i_1) (2 <= h <= k-1) + x(i_h,i_l) (3 <= h <= k-1, 2 <= l < h)
+// D- : + 2 x(i_1,i_h) (3 <= h <= k)   + x(i_h,i_l) (4 <= h <= k, 3 <= l < h)
+// (k == 3 => cycles de longueur 2 releves, ex. x12 + 2 x21 + x23 + x31 <= 2)
+struct LiftedCycle{
+    vector<int> seq; // i_1..i_k
+    bool plus;       // D+ sinon D-
+    double violation; // lhs - (k-1) en sol
+
+    double rhs() const { return static_cast<double>(seq.size()) - 1.0; }
+};
+
+// termes (i, j, coef) de l'inegalite (coefs cumules si un arc apparait 2 fois)
+void liftedCycleTerms(const LiftedCycle &cut, vector<int> &tails, vector<int> &heads, vector<double> &coefs);
+
+// heuristique gloutonne : depuis chaque i_1, ajoute le sommet qui augmente le plus le lhs
+// => D_k+/- violees (k <= maxLen) triees par violation decroissante (au plus maxCuts)
+int findLiftedCycles(const vector<vector<double>> &sol, vector<LiftedCycle> &cuts,
+                     int maxLen = 10, int maxCuts = 10);
+
+// buffers de findLiftedCycles (sequence courante, termes du recalcul) reutilises d'un appel a l'autre
+struct LiftedScratch{
+    vector<char> inSeq;
+    vector<int> seq;
+    LiftedCycle cand;
+    vector<int> tails;
+    vector<int> heads;
+    vector<double> coefs;
+};
+
+int findLiftedCycles(const FlatPoint &sol, vector<LiftedCycle> &cuts, LiftedScratch &scratch,
+                     int maxLen = 10, int maxCuts = 10);
+
+// ---------- MTZ paresseux ----------
+// u_j >= u_i + 1 - (n-1)(1 - x_ij) pour i, j != 0 ; violation == u_i + 1 - (n-1)(1 - x_ij) - u_j
+struct MTZCut{
+    int i;
+    int j;
+    double violation;
+};
+
+// contraintes MTZ violees par (sol, u) triees par violation decroissante (au plus maxCuts)
+// sol entiere : seuls les arcs x_ij == 1 peuvent etre violes (1 par sous tour sans 0 au moins)
+int findMTZViolations(const vector<vector<double>> &sol, const vector<double> &u, vector<MTZCut> &cuts,
+                      int maxCuts = 50);
+int findMTZViolations(const FlatPoint &sol, const vector<double> &u, vector<MTZCut> &cuts, int maxCuts = 50);
+
+// points fractionnaires enregistres (CUT_LP --dump-points) <=> TSP_bench
+void savePoint(ostream &out, const vector<vector<double>> &sol);
+vector<vector<vector<double>>> loadPoints(istream &in);
@@ -0,0 +1,335 @@
+#include "ATSP_Server.hpp"
+#include "ATSP_Stats.hpp"
+#include <cerrno>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// ---------------- cache d'instances ----------------
+
+// chemin => instance lue ; relue si taille / date du fichier changent ; moins recemment utilisee evincee
+class InstanceCache{
+public:
+    explicit InstanceCache(size_t maxSize) : maxSize(maxSize) {}
+
+    // nullptr si illisible ; parseNs == temps de lecture (0 si en cache)
+    shared_ptr<const ATSPDataC> get(const string &path, long long &parseNs){
+        parseNs = 0;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0)
+            {return nullptr;}
+
+        auto it = entries.find(path);
+        if (it != entries.end() && it->second.mtime == static_cast<long long>(st.st_mtime)
+            && it->second.bytes == static_cast<long long>(st.st_size)){
+            it->second.lastUse = ++clock;
+            return it->second.data;
+        }
+
+        long long start = nowNs();
+        shared_ptr<const ATSPDataC> data = make_shared<ATSPDataC>(path);
+        parseNs = nowNs() - start;
+        if (data->size <= 0){
+            entries.erase(path);
+            return nullptr;
+        }
+        if (maxSize == 0)
+            {return data;}
+
+        if (it == entries.end() && entries.size() >= maxSize){
+            auto oldest = entries.begin();
+            for (auto e = entries.begin(); e != entries.end(); ++e)
+                {if (e->second.lastUse < oldest->second.lastUse) oldest = e;}
+            entries.erase(oldest);
+        }
+        Entry &e = entries[path];
+        e.data = data;
+        e.mtime = static_cast<long long>(st.st_mtime);
+        e.bytes = static_cast<long long>(st.st_size);
+        e.lastUse = ++clock;
+        return data;
+    }
+
+private:
+    struct Entry{
+        shared_ptr<const ATSPDataC> data;
+        long long mtime = 0;
+        long long bytes = 0;
+        unsigned long long lastUse = 0;
+    };
+
+    size_t maxSize;
+    map<string, Entry> entries;
+    unsigned long long clock = 0;
+};
+
+// ---------------- requetes ----------------
+
+using LineReader = function<bool(string &)>;
+
+// N x N couts a la suite de "matrix N" (autant de lignes que necessaire)
+static bool readInlineMatrix(int n, const LineReader &readLine, vector<long long> &w){
+    size_t total = static_cast<size_t>(n) * n;
+    w.clear();
+    w.reserve(total);
+    string line;
+    while (w.size() < total && readLine(line)){
+        const char *p = line.data(), *end = p + line.size();
+        long long v;
+        while (w.size() < total && parseInteger(p, end, v))
+            {w.push_back(v);}
+        while (p < end && isBlank(*p))
+            {++p;}
+        if (p < end)
+            {return false;} // mot non entier ou couts en trop
+    }
+    return w.size() == total;
+}
+
+static int reply(int code){
+    cout << "END " << code << endl;
+    return code;
+}
+
+static int replyError(const string &msg){
+    cout << "ERROR " << msg << endl;
+    return reply(1);
+}
+
+static int runHandler(const SolveHandler &solve, const vector<string> &args, const ATSPDataC &data, long long parseNs){
+    try{
+        return reply(solve(args, data, parseNs));
+    }
+    catch (...){
+        return replyError("exception pendant la resolution");
+    }
+}
+
+enum class Session{
+    Continue,
+    Quit,    // fin de la session (connexion / stdin)
+    Shutdown // arret du serveur
+};
+
+static Session handleRequest(const string &line, const LineReader &readLine, InstanceCache &cache, const SolveHandler &solve){
+    istringstream fields(line);
+    string cmd;
+    if (!(fields >> cmd) || cmd[0] == '#')
+        {return Session::Continue;} // ligne vide / commentaire : pas de reponse
+    vector<string> args;
+    for (string arg; fields >> arg; )
+        {args.push_back(arg);}
+
+    if (cmd == "quit")
+        {return Session::Quit;}
+    if (cmd == "shutdown")
+        {return Session::Shutdown;}
+    if (cmd == "ping"){
+        reply(0);
+        return Session::Continue;
+    }
+
+    if (cmd == "solve"){
+        if (args.empty()){
+            replyError("solve PATH [MODE] [options]");
+            return Session::Continue;
+        }
+        long long parseNs = 0;
+        shared_ptr<const ATSPDataC> data = cache.get(args[0], parseNs);
+        if (!data)
+            {replyError("lecture impossible : " + args[0]);}
+        else
+            {runHandler(solve, args, *data, parseNs);}
+        return Session::Continue;
+    }
+
+    if (cmd == "matrix"){
+        int n = args.empty() ? 0 : atoi(args[0].c_str());
+        if (n <= 0){
+            replyError("matrix N [MODE] [options]");
+            return Session::Continue;
+        }
+        long long start = nowNs();
+        vector<long long> w;
+        if (!readInlineMatrix(n, readLine, w)){
+            replyError("matrice invalide (" + to_string(n) + " x " + to_string(n) + " entiers attendus)");
+            return Session::Continue;
+        }
+        ATSPDataC data("inline", n, w);
+        long long parseNs = nowNs() - start;
+        args[0] = "inline"; // nom d'instance des RESULT
+        runHandler(solve, args, data, parseNs);
+        return Session::Continue;
+    }
+
+    replyError("requete inconnue : " + cmd);
+    return Session::Continue;
+}
+
+// requetes d'une source jusqu'a quit / fin de flux / shutdown
+static Session runSession(const LineReader &readLine, InstanceCache &cache, const SolveHandler &solve){
+    string line;
+    while (readLine(line)){
+        Session s = handleRequest(line, readLine, cache, solve);
+        cout.flush();
+        if (s != Session::Continue)
+            {return s;}
+        if (!cout)
+            {return Session::Quit;} // client parti
+    }
+    return Session::Quit;
+}
+
+#ifndef _WIN32
+// ---------------- socket Unix ----------------
+
+// cout => connexion (reponses envoyees au fil de l'eau, RESULT par RESULT)
+class FdBuf : public streambuf{
+public:
+    explicit FdBuf(int fd) : fd(fd) { setp(buf, buf + sizeof(buf)); }
+    ~FdBuf() { sync(); }
+
+protected:
+    int overflow(int c) override{
+        if (sync() != 0)
+            {return traits_type::eof();}
+        if (c != traits_type::eof()){
+            *pptr() = static_cast<char>(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override{
+        for (const char *p = pbase(); p < pptr(); ){
+            ssize_t sent = write(fd, p, pptr() - p);
+            if (sent < 0 && errno == EINTR)
+                {continue;}
+            if (sent <= 0)
+                {return -1;}
+            p += sent;
+        }
+        setp(buf, buf + sizeof(buf));
+        return 0;
+    }
+
+private:
+    int fd;
+    char buf[1 << 14];
+};
+
+// lignes d'une connexion ("\r\n" accepte)
+class FdLines{
+public:
+    explicit FdLines(int fd) : fd(fd) {}
+
+    bool next(string &line){
+        while (true){
+            size_t eol = pending.find('\n', pos);
+            if (eol != string::npos){
+                line.assign(pending, pos, eol - pos);
+                pos = eol + 1;
+                if (!line.empty() && line.back() == '\r')
+                    {line.pop_back();}
+                return true;
+            }
+            pending.erase(0, pos); // ligne partielle seulement (pas de recopie par ligne lue)
+            pos = 0;
+
+            char chunk[1 << 14];
+            ssize_t got = read(fd, chunk, sizeof(chunk));
+            if (got < 0 && errno == EINTR)
+                {continue;}
+            if (got <= 0){
+                if (pending.empty())
+                    {return false;}
+                line.swap(pending); // derniere ligne sans '\n'
+                pending.clear();
+                return true;
+            }
+            pending.append(chunk, static_cast<size_t>(got));
+        }
+    }
+
+private:
+    int fd;
+    string pending;
+    size_t pos = 0;
+};
+
+static int serveSocket(const ServerOptions &options, const SolveHandler &solve){
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (options.socketPath.size() >= sizeof(addr.sun_path)){
+        cerr << "Chemin de socket trop long : " << options.socketPath << endl;
+        return 1;
+    }
+    options.socketPath.copy(addr.sun_path, options.socketPath.size());
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0){
+        cerr << "socket() impossible" << endl;
+        return 1;
+    }
+    unlink(options.socketPath.c_str()); // socket d'un serveur precedent
+    if (bind(server, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(server, 16) != 0){
+        cerr << "Ecoute impossible sur " << options.socketPath << endl;
+        close(server);
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN); // client parti => write() en erreur, pas d'arret du serveur
+    cerr << "Serveur pret : " << options.socketPath << endl;
+
+    InstanceCache cache(options.cacheMax);
+    streambuf *console = cout.rdbuf();
+    Session s = Session::Continue;
+    while (s != Session::Shutdown){
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0){
+            if (errno == EINTR)
+                {continue;}
+            break;
+        }
+        {
+            FdBuf out(client);
+            FdLines in(client);
+            cout.rdbuf(&out);
+            cout.clear();
+            s = runSession([&](string &line) { return in.next(line); }, cache, solve);
+            cout.flush();
+            cout.rdbuf(console);
+            cout.clear();
+        }
+        close(client);
+    }
+
+    close(server);
+    unlink(options.socketPath.c_str());
+    return 0;
+}
+#endif
+
+int serve(const ServerOptions &options, const SolveHandler &solve){
+    if (options.socketPath.empty()){
+        InstanceCache cache(options.cacheMax);
+        runSession([](string &line) { return static_cast<bool>(getline(cin, line)); }, cache, solve);
+        return 0;
+    }
+#ifndef _WIN32
+    return serveSocket(options, solve);
+#else
+    cerr << "--serve SOCKET : sockets Unix non disponibles, utiliser --serve sans chemin (stdin)" << endl;
+    return 1;
+#endif
+}
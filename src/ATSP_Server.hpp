@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "ATSP_Data.hpp"
+
+using namespace std;
+
+// ======================================================================
+// ============== SERVEUR (--serve : socket Unix ou stdin) ==============
+// ======================================================================
+// 1 processus pour beaucoup de petites resolutions : environnement Gurobi (licence) demarre 1 fois,
+// instances lues gardees en cache (chemin => matrice, relue si le fichier change)
+// protocole ligne par ligne, requetes traitees 1 par 1 (1 seul env Gurobi) :
+//   solve PATH [MODE] [options]   instance TSPLIB (options == celles de la ligne de commande)
+//   matrix N [MODE] [options]     + N x N couts a la suite (lignes libres, diagonale ignoree)
+//   ping | quit | shutdown        quit == fin de session (connexion / stdin), shutdown == arret du serveur
+// reponse : sortie de la resolution (RESULT, TOUR ...) puis "END code" ; requete invalide => "ERROR ..." + "END 1"
+
+struct ServerOptions{
+    string socketPath;   // vide == requetes sur stdin, reponses sur stdout
+    size_t cacheMax = 16; // instances gardees (0 == relues a chaque requete)
+};
+
+// args[0] == instance (chemin ou nom), args[1..] == mode + options ; data == instance lue (ou en cache) ;
+// parseNs == temps de lecture de cette requete (0 si en cache) ; renvoie le code de sortie de la resolution
+// ecrit sur cout (redirige vers la connexion)
+using SolveHandler = function<int(const vector<string> &args, const ATSPDataC &data, long long parseNs)>;
+
+// boucle du serveur ; renvoie le code de sortie du processus
+int serve(const ServerOptions &options, const SolveHandler &solve);
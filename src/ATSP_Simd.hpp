@@ -0,0 +1,17 @@
+#pragma once
+
+// noyaux AVX2 : compiles avec __attribute__((target("avx2"))) sans option globale, choisis a l'execution
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ATSP_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// CPU courant compatible AVX2 (false hors x86 ou hors GCC / Clang)
+inline bool cpuHasAvx2(){
+#ifdef ATSP_X86_SIMD
+    static const bool ok = __builtin_cpu_supports("avx2");
+    return ok;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ======================================================================
+// ============== INSTRUMENTATION (compteurs + temps par phase) =========
+// ======================================================================
+// temps stockes en ns (entiers) => cumul pas cher dans le callback
+
+inline long long nowNs(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline double nsToSec(long long ns) { return static_cast<double>(ns) * 1e-9; }
+
+// mutex copiable (copie == nouveau mutex) => SolveStats reste copiable / reaffectable
+struct StatsMutex{
+    std::mutex m;
+    StatsMutex() {}
+    StatsMutex(const StatsMutex &) {}
+    StatsMutex &operator=(const StatsMutex &) { return *this; }
+};
+
+// 1 point de trajectoire (incumbent / borne) ; obj >= 1e99 == pas d'incumbent
+struct TrajectoryPoint{
+    double time;  // secondes depuis le debut d'optimize()
+    double obj;   // meilleure sol entiere
+    double bound; // meilleure borne
+};
+
+struct SolveStats{
+    long long parseNs = 0;    // lecture instance
+    long long buildNs = 0;    // construction modele
+    long long optimizeNs = 0; // optimize() (toutes les passes)
+
+    long long callbackNs = 0;    // temps total dans ATSP_CUT_Callback
+    long long callbackCalls = 0; // nb appels MIPSOL + MIPNODE traites
+
+    long long maxflowNs = 0;    // temps directed_min_cut
+    long long maxflowCalls = 0; // nb appels directed_min_cut
+
+    double estMemMB = 0.0; // memoire estimee avant construction (ATSP_Budget)
+    int candidateK = 0;    // > 0 => modele restreint aux arcs candidats (borne non valide pour l'instance)
+
+    long long lagrNs = 0;         // borne 1-arborescence (ATSP_Bound) ; 0 == pas calculee
+    double lagrBound = 0.0;       // borne lagrangienne (sans LP)
+    long long arcsEliminated = 0; // arcs retires par couts reduits (--arc-elim ; optimum preserve)
+
+    long long rootNs = 0;    // CUT_HYBRID : boucle de coupes racine (0 == pas de boucle racine)
+    double rootBound = 0.0;  // borne LP au passage en entier
+    long long rootKept = 0;  // coupes racine serrees gardees comme lignes du modele entier
+    long long hybridNs = 0;  // CUT_HYBRID : temps mur boucle racine + branch-and-cut (time du RESULT)
+
+    std::string autoRule; // regle retenue par le mode AUTO ("" == mode choisi a la main)
+
+    long long seededCuts = 0;   // nb coupes posees a la construction (attribut Lazy)
+    long long cuts = 0;         // nb coupes ajoutees (lazy + user)
+    double violationSum = 0.0;  // somme des violations des coupes ajoutees
+    std::vector<int> cutsPerRound; // nb coupes par round de separation
+
+    std::vector<TrajectoryPoint> trajectory; // evolution incumbent / borne (GRB_CB_MIP)
+
+    // callbacks Gurobi (Threads > 1) => toute mise a jour depuis un callback passe par add* (verrou)
+    StatsMutex lock;
+
+    void add(long long &counter, long long v){
+        std::lock_guard<std::mutex> guard(lock.m);
+        counter += v;
+    }
+
+    // remise a zero au debut de solve() ; garde ce que l'appelant a mesure (lecture, estimation, borne)
+    void resetForSolve(){
+        SolveStats fresh;
+        fresh.parseNs = parseNs;
+        fresh.estMemMB = estMemMB;
+        fresh.lagrNs = lagrNs;
+        fresh.lagrBound = lagrBound;
+        fresh.autoRule = autoRule;
+        *this = fresh;
+    }
+
+    // 1 round de separation == 1 passe LP (CUT_LP) ou 1 callback qui coupe
+    void addRound(int nbCuts){
+        if (nbCuts > 0){
+            std::lock_guard<std::mutex> guard(lock.m);
+            cutsPerRound.push_back(nbCuts);
+        }
+    }
+
+    void addCut(double violation){
+        std::lock_guard<std::mutex> guard(lock.m);
+        cuts++;
+        violationSum += violation;
+    }
+
+    // ajoute 1 point seulement si incumbent ou borne a change
+    void addTrajectory(double time, double obj, double bound){
+        std::lock_guard<std::mutex> guard(lock.m);
+        if (!trajectory.empty()){
+            const TrajectoryPoint &last = trajectory.back();
+            if (last.obj == obj && last.bound == bound)
+                {return;}
+        }
+        trajectory.push_back({time, obj, bound});
+    }
+
+    double avgViolation() const { return cuts > 0 ? violationSum / cuts : 0.0; }
+
+    double avgCutsPerRound() const{
+        return cutsPerRound.empty() ? 0.0 : static_cast<double>(cuts) / cutsPerRound.size();
+    }
+};
+
+// cumule le temps du scope dans *acc (rien si acc == nullptr)
+// owner != nullptr => cumul sous le verrou de owner (depuis un callback)
+class ScopedTimer{
+private:
+    long long *acc;
+    SolveStats *owner;
+    long long start;
+
+public:
+    explicit ScopedTimer(long long *acc, SolveStats *owner = nullptr)
+        : acc(acc), owner(owner), start(acc ? nowNs() : 0) {}
+    ~ScopedTimer(){
+        if (!acc)
+            {return;}
+        if (owner)
+            {owner->add(*acc, nowNs() - start);}
+        else
+            {*acc += nowNs() - start;}
+    }
+};
@@ -0,0 +1,208 @@
+#include "STSP_CUT.hpp"
+#include <chrono>
+
+using namespace std;
+
+
+GRBLinExpr combExpr(const vector<vector<GRBVar>> &x, const Comb &comb){
+    GRBLinExpr lhs = 0;
+    // x(E(V)) pour V == H puis chaque dent
+    auto addInner = [&](const vector<int> &V){
+        for (size_t a = 0; a < V.size(); ++a)
+            {for (size_t b = a + 1; b < V.size(); ++b)
+                {lhs += x[V[a]][V[b]];}}
+    };
+
+    addInner(comb.handle);
+    for (const vector<int> &T : comb.teeth)
+        {addInner(T);}
+    return lhs;
+}
+
+
+STSP_CUT::STSP_CUT(ATSPDataC data, SolveMode mode)
+    : data(data), status(0), lazyCuts(0), userCuts(0), mode(mode) {}
+
+void STSP_CUT::solve(){
+    try{
+        lazyCuts = 0;
+        userCuts = 0;
+
+        stats.resetForSolve(); // garde lecture / estimation mesurees par l'appelant
+        long long buildStart = nowNs();
+
+        if (!env){
+            env = std::make_shared<GRBEnv>(true);
+            env->set("LogFile", "stsp_cut.log");
+            env->start();
+        }
+
+        model = std::make_unique<GRBModel>(*env);
+        GRBModel &modelRef = *model;
+
+        const int n = data.size;
+        const char xType = (mode == SolveMode::FractionalLP) ? GRB_CONTINUOUS : GRB_BINARY; // int or double depending on the current mode
+
+        // Variables
+        // x_e pour e == {i,j}, i < j (cout porte par la var, ModelSense min par defaut)
+        x.assign(n, vector<GRBVar>(n));
+        for (int i = 0; i < n; ++i){
+            for (int j = i + 1; j < n; ++j){
+                x[i][j] = modelRef.addVar(0.0, 1.0, data.dist(i, j), xType, "x(" + to_string(i) + "," + to_string(j) + ")");
+                x[j][i] = x[i][j];
+            }
+        }
+
+        // Contraintes
+        // sum_j j!=i x[i][j] == 2 for all i in N
+        for (int i = 0; i < n; ++i){
+            GRBLinExpr deg = 0;
+            for (int j = 0; j < n; ++j)
+                {if (i != j) deg += x[i][j];}
+            modelRef.addConstr(deg == 2, "deg(" + to_string(i) + ")");
+        }
+
+        modelRef.set(GRB_DoubleParam_TimeLimit, params.timeLimit);
+        modelRef.set(GRB_IntParam_Threads, params.threads);
+        stats.buildNs = nowNs() - buildStart;
+
+        if (mode == SolveMode::IntegerMIP){
+            modelRef.set(GRB_IntParam_LazyConstraints, 1);
+            std::unique_ptr<STSP_CUT_Callback> cb(new STSP_CUT_Callback(n, x, &lazyCuts, &userCuts, &stats));
+            modelRef.setCallback(cb.get());
+
+            {
+                ScopedTimer optTimer(&stats.optimizeNs);
+                modelRef.optimize();
+            }
+            setterStatus(modelRef.get(GRB_IntAttr_Status));
+        }
+        else{
+            auto start = std::chrono::steady_clock::now();
+            double timeLimit = params.timeLimit;
+            STSPScratch w; // aretes a plat + buffers de separation, alloues 1 fois
+            w.init(-1, n, x);
+            int nEdges = static_cast<int>(w.edges.size());
+
+            while (true){
+                double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+                double remaining = timeLimit - elapsed;
+
+                if (remaining <= 0.0)
+                    {break;}
+
+                modelRef.set(GRB_DoubleParam_TimeLimit, remaining);
+                {
+                    ScopedTimer optTimer(&stats.optimizeNs);
+                    modelRef.optimize(); // optimise relax
+                }
+                setterStatus(modelRef.get(GRB_IntAttr_Status));
+
+                int status = getterStatus();
+                if (status != GRB_OPTIMAL && status != GRB_TIME_LIMIT)
+                    {break;}
+
+                // si pas sol => stop
+                if (modelRef.get(GRB_IntAttr_SolCount) == 0)
+                    {break;}
+
+                double lpTime = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+                stats.addTrajectory(lpTime, GRB_INFINITY, modelRef.get(GRB_DoubleAttr_ObjVal));
+
+                // reconstruit sol[i][j] (symetrique) en 1 seul get
+                // (l'API C++ renvoie un tableau alloue par new[] => 1 delete[] par round)
+                double *vals = modelRef.get(GRB_DoubleAttr_X, w.edges.data(), nEdges);
+                for (int k = 0; k < nEdges; ++k)
+                    {w.sol[w.edgeTail[k]][w.edgeHead[k]] = w.sol[w.edgeHead[k]][w.edgeTail[k]] = vals[k];}
+                delete[] vals;
+                const FlatPoint &sol = w.sol;
+
+                double violation = 0.0;
+                // cherche coupe violee : sous tour puis peignes
+                if (findSymFractionalCut_S(sol, w.S, &stats, &violation)){
+                    CutRow &row = w.row;
+                    sparsestSubtourRow(n, w.S, true, row, w.inS); // forme la plus creuse
+                    modelRef.addConstr(cutRowExpr(x, row, w.rowVars, w.rowCoefs), row.sense, row.rhs); // ajoute user cut
+                    userCuts++; // +1 compteur
+                    stats.addCut(violation);
+                    stats.addRound(1);
+                }
+                else{
+                    vector<Comb> &combs = w.combs;
+                    if (findCombs(sol, combs) == 0)
+                        {break;} // aucune violation
+
+                    for (const Comb &comb : combs){
+                        modelRef.addConstr(combExpr(x, comb) <= comb.rhs()); // ajoute peigne
+                        userCuts++;
+                        stats.addCut(comb.violation);
+                    }
+                    stats.addRound(static_cast<int>(combs.size()));
+                }
+
+                if (getterStatus() == GRB_TIME_LIMIT)
+                    {break;}
+            }
+        }
+    }
+    catch (GRBException e){
+        cerr << "Error code = " << e.getErrorCode() << endl;
+        cerr << e.getMessage() << endl;
+    }
+    catch (...)
+    {  cerr << "Exception during optimization" << endl;}
+}
+
+vector<int> STSP_CUT::getterTour(){
+    vector<int> tour;
+    if (!model || mode == SolveMode::FractionalLP)
+        {return tour;}
+    try{
+        if (model->get(GRB_IntAttr_SolCount) == 0)
+            {return tour;}
+        int n = data.size;
+        vector<char> seen(n, 0);
+        for (int v = 0; v >= 0; ){
+            tour.push_back(v);
+            seen[v] = 1;
+            int next = -1;
+            for (int j = 0; j < n && next < 0; ++j){
+                if (j != v && !seen[j] && x[v][j].get(GRB_DoubleAttr_X) > 0.5)
+                    {next = j;}
+            }
+            v = next;
+        }
+        if (static_cast<int>(tour.size()) != n)
+            {tour.clear();} // sous tours
+    }
+    catch (GRBException e)
+        {tour.clear();}
+    return tour;
+}
+
+void STSP_CUT::printSolution(){
+    if (!model){
+        cerr << "Fail -- run solve() first in the main" << endl;
+        return;
+    }
+
+    GRBModel &modelRef = *model;
+    int status = getterStatus();
+
+    if (status == GRB_OPTIMAL || (status == GRB_TIME_LIMIT && modelRef.get(GRB_IntAttr_SolCount) > 0)){
+        cout << "Succes! (Status: " << status << ")" << endl;
+        cout << "Runtime : " << modelRef.get(GRB_DoubleAttr_Runtime) << " seconds" << endl;
+        modelRef.write("solution.sol");
+        cout << "Objective value = " << modelRef.get(GRB_DoubleAttr_ObjVal) << endl;
+        for (int i = 0; i < data.size; ++i){
+            for (int j = i + 1; j < data.size; ++j){
+                if (x[i][j].get(GRB_DoubleAttr_X) > 0.5){
+                    cout << "x(" << i << "," << j << ") = " << x[i][j].get(GRB_DoubleAttr_X) << endl;
+                }
+            }
+        }
+    }
+    else{
+        cerr << "Fail! (Status: " << status << ")" << endl;
+    }
+}
@@ -0,0 +1,230 @@
+#pragma once
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include "gurobi_c++.h"
+#include "ATSP_Data.hpp"
+#include "ATSP_Stats.hpp"
+#include "ATSP_Sep.hpp"
+#include "ATSP_Params.hpp"
+#include "ATSP_CUT.hpp" // cutRowExpr
+
+// ======================================================================
+// ============== CLASS STSP_CUT (TSP symetrique, aretes) ===============
+// ======================================================================
+// x_e pour i < j (n(n-1)/2 vars), degre 2, coupes x(delta(S)) >= 2
+// x[i][j] et x[j][i] == meme variable
+class STSP_CUT{
+private:
+    ATSPDataC data;
+    std::shared_ptr<GRBEnv> env; // propre au solveur, ou partage (setterEnv, --serve)
+    std::unique_ptr<GRBModel> model;
+    int status;
+
+    vector<vector<GRBVar>> x; // x[i][j] == x[j][i] == var decision arete {i,j}
+
+    atomic<int> lazyCuts; // nb lazy cuts ajoutees (atomique : callback multi thread)
+    atomic<int> userCuts; // "  user   "     "
+
+    SolveStats stats; // instrumentation
+
+    SolverParams params; // threads, temps limite
+
+public:
+    enum class SolveMode{
+        IntegerMIP,  // solve entier
+        FractionalLP // solve frac (relax LP)
+    };
+
+private:
+    SolveMode mode; // mode courant (int or double)
+
+public:
+    // Setters & Getters
+    void setterStatus(int status) { this->status = status; }
+    GRBModel *getterModel() { return this->model.get(); }
+    vector<vector<GRBVar>> &getterX() { return this->x; }
+    int getterStatus() { return this->status; }
+    int getLazyCuts() const { return lazyCuts; }
+    int getUserCuts() const { return userCuts; }
+    int getTotalCuts() const { return lazyCuts + userCuts; } // total cuts (user + lazy)
+    SolveMode getMode() const { return mode; }
+    SolveStats &getterStats() { return stats; }
+    void setterParams(const SolverParams &params) { this->params = params; }
+    void setterEnv(const std::shared_ptr<GRBEnv> &env) { this->env = env; } // avant solve() : pas de demarrage d'env
+
+    // Constructeur
+    STSP_CUT(ATSPDataC data, SolveMode mode = SolveMode::IntegerMIP);
+
+    void solve();         // build + solve model
+    void printSolution(); // affiche sol
+
+    // tour de la derniere sol entiere depuis 0 (sens : plus petit voisin d'abord) ; vide si pas de sol
+    vector<int> getterTour();
+};
+
+// comb == x(E(H)) + sum_i x(E(T_i)) (<= comb.rhs())
+GRBLinExpr combExpr(const vector<vector<GRBVar>> &x, const Comb &comb);
+
+// buffers de separation symetrique d'un thread (cf. CutScratch)
+struct STSPScratch{
+    long owner = -1;         // id du callback qui les a dimensionnes
+    vector<GRBVar> edges;    // x[i][j] i < j a plat (ordre ligne)
+    vector<int> edgeTail;    // i de edges[k]
+    vector<int> edgeHead;    // j de edges[k]
+    FlatPoint sol;           // point courant n x n a plat (symetrique, diagonale == 0)
+    vector<int> S;           // cote S de la coupe
+    CutRow row;              // coupe sous tour creuse
+    vector<GRBVar> rowVars;  // vars de row (addTerms)
+    vector<double> rowCoefs; // coefs de row (== 1)
+    vector<char> inS;        // marquage de S (sparsestSubtourRow)
+    vector<Comb> combs;      // peignes du point (MIPNODE sans sous tour)
+
+    void init(long id, int n, const vector<vector<GRBVar>> &x){
+        owner = id;
+        edges.clear();
+        edgeTail.clear();
+        edgeHead.clear();
+        for (int i = 0; i < n; ++i){
+            for (int j = i + 1; j < n; ++j){
+                edges.push_back(x[i][j]);
+                edgeTail.push_back(i);
+                edgeHead.push_back(j);
+            }
+        }
+        sol.assign(n);
+        S.clear();
+        S.reserve(n);
+    }
+};
+
+// ======================================================================
+// ============== CLASS STSP_CUT_CALLBACK :: GRBCALLBACK ================
+// ======================================================================
+// Threads > 1 : compteurs atomiques, buffers par thread
+class STSP_CUT_Callback : public GRBCallback{
+private:
+    int n;                     // taille instance
+    vector<vector<GRBVar>> &x; // ref vars x (symetrique)
+
+    atomic<int> *lazyCuts; // ptr comptaur lazy
+    atomic<int> *userCuts; //  "     "     user
+
+    SolveStats *stats; // instrumentation (optionnel)
+
+    long id; // identifiant unique => buffers thread_local redimensionnes si autre callback
+
+    static long nextId(){
+        static atomic<long> counter(0);
+        return counter++;
+    }
+
+public:
+    STSP_CUT_Callback(int n, vector<vector<GRBVar>> &x, atomic<int> *lazyCuts, atomic<int> *userCuts,
+                      SolveStats *stats = nullptr)
+        : n(n), x(x), lazyCuts(lazyCuts), userCuts(userCuts), stats(stats), id(nextId()) {}
+
+private:
+    // buffers du thread courant (1 allocation par thread et par callback)
+    STSPScratch &scratch(){
+        thread_local STSPScratch w;
+        if (w.owner != id)
+            {w.init(id, n, x);}
+        return w;
+    }
+
+    // recupere le point MIPSOL / MIPNODE en 1 seul appel Gurobi => w.sol (symetrique)
+    // (l'API C++ renvoie un tableau alloue par new[] => 1 delete[] par appel)
+    void fetchPoint(STSPScratch &w){
+        int nEdges = static_cast<int>(w.edges.size());
+        double *vals = (where == GRB_CB_MIPSOL) ? getSolution(w.edges.data(), nEdges)
+                                                : getNodeRel(w.edges.data(), nEdges);
+        for (int k = 0; k < nEdges; ++k)
+            {w.sol[w.edgeTail[k]][w.edgeHead[k]] = w.sol[w.edgeHead[k]][w.edgeTail[k]] = vals[k];}
+        delete[] vals;
+    }
+
+protected:
+    void callback(){
+        // trajectoire incumbent / borne
+        if (where == GRB_CB_MIP){
+            if (stats){
+                try{
+                    stats->addTrajectory(getDoubleInfo(GRB_CB_RUNTIME), getDoubleInfo(GRB_CB_MIP_OBJBST),
+                                         getDoubleInfo(GRB_CB_MIP_OBJBND));
+                }
+                catch (GRBException e)
+                    { cerr << "Erreur callback : " << e.getMessage() << endl; }
+            }
+            return;
+        }
+
+        if (where != GRB_CB_MIPSOL && where != GRB_CB_MIPNODE)
+            {return;} // rien a separer
+
+        ScopedTimer timer(stats ? &stats->callbackNs : nullptr, stats);
+        if (stats)
+            {stats->add(stats->callbackCalls, 1);}
+
+        try{
+            // sol frac : MIPNODE sur relax optimale seulement
+            if (where == GRB_CB_MIPNODE && getIntInfo(GRB_CB_MIPNODE_STATUS) != GRB_OPTIMAL)
+                {return;}
+
+            STSPScratch &w = scratch(); // buffers du thread courant
+            const FlatPoint &sol = w.sol;
+            CutRow &row = w.row;
+            fetchPoint(w);
+
+            // sol entiere : 1 coupe par composante connexe (sous tour)
+            if (where == GRB_CB_MIPSOL){
+                vector<vector<int>> comps = findComponents(sol, 0.5);
+                if (comps.size() <= 1)
+                    {return;} // tour hamiltonien
+
+                for (const vector<int> &S : comps){
+                    sparsestSubtourRow(n, S, true, row, w.inS); // forme la plus creuse
+                    addLazy(cutRowExpr(x, row, w.rowVars, w.rowCoefs), row.sense, row.rhs);
+                    if (lazyCuts)
+                        {(*lazyCuts)++;}
+                    if (stats)
+                        {stats->addCut(2.0);} // x(delta(S)) == 0 en sol entiere
+                }
+                if (stats)
+                    {stats->addRound(static_cast<int>(comps.size()));}
+                return;
+            }
+
+            // sol frac : composantes puis coupe globale min (Stoer-Wagner)
+            vector<int> &S = w.S;
+            double violation = 0.0;
+            if (findSymFractionalCut_S(sol, S, stats, &violation)){
+                sparsestSubtourRow(n, S, true, row, w.inS); // forme la plus creuse
+                addCut(cutRowExpr(x, row, w.rowVars, w.rowCoefs), row.sense, row.rhs); // ajoute user cut
+                if (userCuts)
+                    {(*userCuts)++;}
+                if (stats){
+                    stats->addCut(violation);
+                    stats->addRound(1);
+                }
+                return;
+            }
+
+            // pas de sous tour viole => peignes / blossoms
+            vector<Comb> &combs = w.combs;
+            if (findCombs(sol, combs) > 0){
+                for (const Comb &comb : combs){
+                    addCut(combExpr(x, comb) <= comb.rhs());
+                    if (userCuts)
+                        {(*userCuts)++;}
+                    if (stats)
+                        {stats->addCut(comb.violation);}
+                }
+                if (stats)
+                    {stats->addRound(static_cast<int>(combs.size()));}
+            }
+        }
+        catch (GRBException e)
+            { cerr << "Erreur callback : " << e.getMessage() << endl; }
+    }
+};
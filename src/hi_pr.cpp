@@ -318,33 +318,34 @@ int parse( double  **x,      /* capa */
 #define GREY 1
 #define BLACK 2
 
-/* global variables */
-
-long   n;                    /* number of nodes */
-long   m;                    /* number of arcs */
-long   nm;                   /* n + ALPHA * m */
-long   nMin;                 /* smallest node id */
-node   *nodes;               /* array of nodes */
-arc    *arcs;                /* array of arcs */
-bucket *buckets;             /* array of buckets */
-cType  *cap;                 /* array of capacities */
-node   *source;              /* source node pointer */
-node   *sink;                /* sink node pointer */
-node   **queue;              /* queue for BFS */
-node   **qHead, **qTail, **qLast;     /* queue pointers */
-long   dMax;                 /* maximum label */
-long   aMax;                 /* maximum actie node label */
-long   aMin;                 /* minimum active node label */
-double flow;                 /* flow value */
-long pushCnt  = 0;           /* number of pushes */
-long relabelCnt   = 0;       /* number of relabels */
-long updateCnt    = 0;       /* number of updates */
-long gapCnt   = 0;           /* number of gaps */
-long gNodeCnt = 0;           /* number of nodes after gap */  
-node   *sentinelNode;        /* end of the node list marker */
-arc *stopA;                  /* used in forAllArcs */
-long workSinceUpdate=0;      /* the number of arc scans since last update */
-float globUpdtFreq;          /* global update frequency */
+/* global variables (thread_local: one solver state per thread, so
+   concurrent calls from Gurobi callback threads do not share it) */
+
+thread_local long   n;                    /* number of nodes */
+thread_local long   m;                    /* number of arcs */
+thread_local long   nm;                   /* n + ALPHA * m */
+thread_local long   nMin;                 /* smallest node id */
+thread_local node   *nodes;               /* array of nodes */
+thread_local arc    *arcs;                /* array of arcs */
+thread_local bucket *buckets;             /* array of buckets */
+thread_local cType  *cap;                 /* array of capacities */
+thread_local node   *source;              /* source node pointer */
+thread_local node   *sink;                /* sink node pointer */
+thread_local node   **queue;              /* queue for BFS */
+thread_local node   **qHead, **qTail, **qLast;     /* queue pointers */
+thread_local long   dMax;                 /* maximum label */
+thread_local long   aMax;                 /* maximum actie node label */
+thread_local long   aMin;                 /* minimum active node label */
+thread_local double flow;                 /* flow value */
+thread_local long pushCnt  = 0;           /* number of pushes */
+thread_local long relabelCnt   = 0;       /* number of relabels */
+thread_local long updateCnt    = 0;       /* number of updates */
+thread_local long gapCnt   = 0;           /* number of gaps */
+thread_local long gNodeCnt = 0;           /* number of nodes after gap */  
+thread_local node   *sentinelNode;        /* end of the node list marker */
+thread_local arc *stopA;                  /* used in forAllArcs */
+thread_local long workSinceUpdate=0;      /* the number of arc scans since last update */
+thread_local float globUpdtFreq;          /* global update frequency */
 
 /* macros */
 
@@ -387,7 +388,7 @@ float globUpdtFreq;          /* global update frequency */
      operations iAdd, iDelete (from arbitrary position)
 */
 
-long i_dist;
+thread_local long i_dist;
 
 #define aAdd(l,i)\
 {\
@@ -406,7 +407,7 @@ long i_dist;
   l->firstActive = i->bNext;\
 }
 
-node *i_next, *i_prev;
+thread_local node *i_next, *i_prev;
 #define iAdd(l,i)\
 {\
   i_next = l->firstInactive;\
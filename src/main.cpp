@@ -1,7 +1,17 @@
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include "ATSP_MTZ.hpp"
 #include "ATSP_CUT.hpp"
+#include "STSP_CUT.hpp"
+#include "ATSP_Budget.hpp"
+#include "ATSP_HeldKarp.hpp"
+#include "ATSP_Bound.hpp"
+#include "ATSP_Auto.hpp"
+#include "ATSP_Server.hpp"
+#include "ATSP_Checkpoint.hpp"
 
 using namespace std;
 
@@ -46,8 +56,49 @@ static bool tryGetDoubleAttr(GRBModel &model, GRB_DoubleAttr attr, double &out)
   }
 }
 
-// Affiche main
-static void printSummary(const string &instance, const string &mode, GRBModel &model, int status, int cuts) {
+// Echappe une chaine pour JSON (noms de fichiers)
+static string jsonEscape(const string &s) {
+  string out;
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      out += '\\';
+    out += c;
+  }
+  return out;
+}
+
+// valeur de trajectoire (obj >= 1e99 == pas d'incumbent)
+static string trajValue(double v, const string &na) {
+  return (v >= 1e99 || v <= -1e99) ? na : to_string(v);
+}
+
+// Affiche la trajectoire incumbent / borne (1 ligne TRAJ par changement)
+// arcs candidats => bornes du modele restreint, pas de l'instance : NA
+static void printTrajectory(const SolveStats &stats) {
+  bool restricted = stats.candidateK > 0;
+  for (const TrajectoryPoint &p : stats.trajectory) {
+    cout << "TRAJ time=" << to_string(p.time)
+         << " obj=" << trajValue(p.obj, "NA")
+         << " bound=" << (restricted ? string("NA") : trajValue(p.bound, "NA")) << endl;
+  }
+}
+
+// valeurs du RESULT (modele Gurobi ou Held-Karp)
+struct SolveSummary {
+  bool hasObj = false;
+  double obj = 0.0;
+  bool hasBound = false;
+  double bound = 0.0;
+  bool hasNodes = false;
+  double nodes = 0.0;
+  bool hasTime = false;
+  double runtime = 0.0;
+  string status = "NA";
+  string solver = "gurobi"; // gurobi | held_karp | arborescence
+};
+
+static SolveSummary summaryFromModel(GRBModel &model, int status) {
+  SolveSummary s;
   int solCount = 0;
 
   try {
@@ -56,83 +107,640 @@ static void printSummary(const string &instance, const string &mode, GRBModel &m
   catch (GRBException &) {
   }
 
-  double obj = 0.0;
-  bool hasObj = (solCount > 0) && tryGetDoubleAttr(model, GRB_DoubleAttr_ObjVal, obj);
+  s.hasObj = (solCount > 0) && tryGetDoubleAttr(model, GRB_DoubleAttr_ObjVal, s.obj);
+  s.hasBound = tryGetDoubleAttr(model, GRB_DoubleAttr_ObjBound, s.bound);
+  s.hasTime = tryGetDoubleAttr(model, GRB_DoubleAttr_Runtime, s.runtime);
+  s.hasNodes = tryGetDoubleAttr(model, GRB_DoubleAttr_NodeCount, s.nodes);
+  s.status = statusToString(status);
+  return s;
+}
 
-  double bound = 0.0;
-  bool hasBound = tryGetDoubleAttr(model, GRB_DoubleAttr_ObjBound, bound);
+// Affiche main
+// RESULT == ligne key=value ; json == meme contenu + detail des rounds en JSON
+// arcs candidats (candidate_k > 0) : optimum / borne du graphe restreint => status X_RESTRICTED, bound NA
+static void printSummary(const string &instance, const string &mode, const SolveSummary &s, int cuts,
+                         const SolveStats &stats, bool summary, bool json, bool trace) {
+  bool restricted = stats.candidateK > 0;
+  bool hasObj = s.hasObj, hasBound = s.hasBound && !restricted, hasNodes = s.hasNodes, hasTime = s.hasTime;
+  bool hasRoot = stats.rootNs > 0 && !restricted;
+  double obj = s.obj, bound = s.bound, nodes = s.nodes, runtime = s.runtime;
+  if (stats.hybridNs > 0) { // CUT_HYBRID : racine + branch-and-cut, pas seulement le dernier optimize()
+    hasTime = true;
+    runtime = nsToSec(stats.hybridNs);
+  }
+  string status = restricted ? s.status + "_RESTRICTED" : s.status;
 
-  double runtime = 0.0;
-  bool hasTime = tryGetDoubleAttr(model, GRB_DoubleAttr_Runtime, runtime);
+  if (trace)
+    printTrajectory(stats);
 
-  double nodes = 0.0;
-  bool hasNodes = tryGetDoubleAttr(model, GRB_DoubleAttr_NodeCount, nodes);
-
-  cout << "RESULT instance=" << instance
-       << " mode=" << mode
-       << " obj=" << (hasObj ? to_string(obj) : string("NA"))
-       << " bound=" << (hasBound ? to_string(bound) : string("NA"))
-       << " nodes=" << (hasNodes ? to_string(static_cast<long long>(nodes)) : string("NA"))
-       << " cuts=" << cuts
-       << " status=" << statusToString(status)
-       << " time=" << (hasTime ? to_string(runtime) : string("NA"))
-       << endl;
+  if (summary) {
+    cout << "RESULT instance=" << instance
+         << " mode=" << mode
+         << " obj=" << (hasObj ? to_string(obj) : string("NA"))
+         << " bound=" << (hasBound ? to_string(bound) : string("NA"))
+         << " nodes=" << (hasNodes ? to_string(static_cast<long long>(nodes)) : string("NA"))
+         << " cuts=" << cuts
+         << " status=" << status
+         << " time=" << (hasTime ? to_string(runtime) : string("NA"))
+         << " parse_time=" << to_string(nsToSec(stats.parseNs))
+         << " build_time=" << to_string(nsToSec(stats.buildNs))
+         << " opt_time=" << to_string(nsToSec(stats.optimizeNs))
+         << " cb_time=" << to_string(nsToSec(stats.callbackNs))
+         << " cb_calls=" << stats.callbackCalls
+         << " maxflow_calls=" << stats.maxflowCalls
+         << " maxflow_time=" << to_string(nsToSec(stats.maxflowNs))
+         << " rounds=" << stats.cutsPerRound.size()
+         << " cuts_per_round=" << to_string(stats.avgCutsPerRound())
+         << " avg_viol=" << to_string(stats.avgViolation())
+         << " seeded=" << stats.seededCuts
+         << " est_mem_mb=" << to_string(stats.estMemMB)
+         << " peak_rss_mb=" << to_string(peakRssMB())
+         << " candidate_k=" << stats.candidateK
+         << " lagr_bound=" << (stats.lagrNs > 0 ? to_string(stats.lagrBound) : string("NA"))
+         << " lagr_time=" << to_string(nsToSec(stats.lagrNs))
+         << " arcs_elim=" << stats.arcsEliminated
+         << " auto_rule=" << (stats.autoRule.empty() ? string("NA") : stats.autoRule)
+         << " root_bound=" << (hasRoot ? to_string(stats.rootBound) : string("NA"))
+         << " root_time=" << to_string(nsToSec(stats.rootNs))
+         << " root_kept=" << stats.rootKept
+         << " solver=" << s.solver
+         << endl;
+  }
+
+  if (json) {
+    cout << "{\"instance\":\"" << jsonEscape(instance) << "\""
+         << ",\"mode\":\"" << mode << "\""
+         << ",\"obj\":" << (hasObj ? to_string(obj) : string("null"))
+         << ",\"bound\":" << (hasBound ? to_string(bound) : string("null"))
+         << ",\"nodes\":" << (hasNodes ? to_string(static_cast<long long>(nodes)) : string("null"))
+         << ",\"cuts\":" << cuts
+         << ",\"status\":\"" << status << "\""
+         << ",\"time\":" << (hasTime ? to_string(runtime) : string("null"))
+         << ",\"parse_time\":" << to_string(nsToSec(stats.parseNs))
+         << ",\"build_time\":" << to_string(nsToSec(stats.buildNs))
+         << ",\"opt_time\":" << to_string(nsToSec(stats.optimizeNs))
+         << ",\"cb_time\":" << to_string(nsToSec(stats.callbackNs))
+         << ",\"cb_calls\":" << stats.callbackCalls
+         << ",\"maxflow_calls\":" << stats.maxflowCalls
+         << ",\"maxflow_time\":" << to_string(nsToSec(stats.maxflowNs))
+         << ",\"avg_viol\":" << to_string(stats.avgViolation())
+         << ",\"seeded\":" << stats.seededCuts
+         << ",\"est_mem_mb\":" << to_string(stats.estMemMB)
+         << ",\"peak_rss_mb\":" << to_string(peakRssMB())
+         << ",\"candidate_k\":" << stats.candidateK
+         << ",\"lagr_bound\":" << (stats.lagrNs > 0 ? to_string(stats.lagrBound) : string("null"))
+         << ",\"lagr_time\":" << to_string(nsToSec(stats.lagrNs))
+         << ",\"arcs_elim\":" << stats.arcsEliminated
+         << ",\"auto_rule\":" << (stats.autoRule.empty() ? string("null") : "\"" + stats.autoRule + "\"")
+         << ",\"root_bound\":" << (hasRoot ? to_string(stats.rootBound) : string("null"))
+         << ",\"root_time\":" << to_string(nsToSec(stats.rootNs))
+         << ",\"root_kept\":" << stats.rootKept
+         << ",\"solver\":\"" << s.solver << "\""
+         << ",\"cuts_per_round\":[";
+    for (size_t r = 0; r < stats.cutsPerRound.size(); ++r)
+      cout << (r ? "," : "") << stats.cutsPerRound[r];
+    cout << "],\"trajectory\":[";
+    for (size_t r = 0; r < stats.trajectory.size(); ++r) {
+      const TrajectoryPoint &p = stats.trajectory[r];
+      cout << (r ? "," : "") << "[" << to_string(p.time) << "," << trajValue(p.obj, "null")
+           << "," << (restricted ? string("null") : trajValue(p.bound, "null")) << "]";
+    }
+    cout << "]}" << endl;
+  }
+}
+
+static void printSummary(const string &instance, const string &mode, GRBModel &model, int status, int cuts,
+                         const SolveStats &stats, bool summary, bool json, bool trace) {
+  printSummary(instance, mode, summaryFromModel(model, status), cuts, stats, summary, json, trace);
 }
 // --------------- END--------------- 
 
-int main(int argc, char **argv) {
-  if (argc < 2) {
-    cout << "usage : " << argv[0] << " ATSPFilename [MTZ|CUT|CUT_LP] [--summary]" << endl;
-    return 0;
+// --reopt FILE : 1 lot de modifications de couts, lignes "i j cout" (sommets 0..n-1, '#' == commentaire)
+static bool readArcCosts(const string &path, int n, vector<ArcCost> &changes) {
+  ifstream in(path);
+  if (!in) {
+    return false;
+  }
+  string line;
+  while (getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    ArcCost c;
+    istringstream fields(line);
+    if (!(fields >> c.i >> c.j >> c.cost) || c.i < 0 || c.j < 0 || c.i >= n || c.j >= n || c.i == c.j) {
+      cerr << path << " : ligne invalide '" << line << "'" << endl;
+      return false;
+    }
+    changes.push_back(c);
   }
+  return true;
+}
 
+// apres le 1er solve : 1 reoptimisation par lot (meme modele, coupes et dernier tour gardes), 1 RESULT par lot
+// --tour : "TOUR v0 v1 ... " depuis 0 ("TOUR NA" si pas de tour)
+static void printTour(const vector<int> &tour) {
+  cout << "TOUR";
+  if (tour.empty()) {
+    cout << " NA";
+  }
+  for (int v : tour) {
+    cout << " " << v;
+  }
+  cout << endl;
+}
+
+template <class Solver>
+static void runReopt(Solver &solver, const vector<vector<ArcCost>> &batches, const string &instance,
+                     const string &mode, bool summary, bool json, bool trace, bool tour) {
+  for (size_t k = 0; k < batches.size(); ++k) {
+    solver.reoptimize(batches[k]);
+    if (!solver.getterModel()) {
+      return;
+    }
+    if (summary || json || trace) {
+      printSummary(instance, mode, *solver.getterModel(), solver.getterStatus(), solver.getTotalCuts(), solver.getterStats(), summary, json, trace);
+    }
+    else {
+      double obj = 0.0;
+      cout << "Reoptimisation " << k + 1 << " (" << batches[k].size() << " arcs) : ";
+      if (tryGetDoubleAttr(*solver.getterModel(), GRB_DoubleAttr_ObjVal, obj)) {
+        cout << obj;
+      }
+      else {
+        cout << "NA";
+      }
+      cout << " (" << nsToSec(solver.getterStats().optimizeNs) << " seconds)" << endl;
+    }
+    if (tour) {
+      printTour(solver.getterTour());
+    }
+  }
+}
+
+// 1 resolution : args == argv[1..] (args[0] == instance)
+// inst != nullptr => instance deja lue (--serve : cache, matrice en ligne), lue en instParseNs
+// env != nullptr => environnement Gurobi partage (pas de demarrage ni de licence par resolution)
+static int runSolve(const vector<string> &args, const ATSPDataC *inst, long long instParseNs, const shared_ptr<GRBEnv> &env) {
+  const string &path = args[0];
+  const string instance = baseName(path);
   string mode = "MTZ";
   bool summary = false;
-  for (int i = 2; i < argc; ++i) {  string arg = argv[i];
+  bool json = false;
+  bool trace = false;
+  bool directed = false; // force le modele oriente sur une instance symetrique
+  bool tour = false;     // --tour : ligne TOUR apres chaque RESULT
+  string pointsFile;
+  SolverParams params; // --threads (0 == auto Gurobi), --time-limit
+  double memBudget = 0.0; // Mo, 0 == pas de controle
+  vector<string> reoptFiles; // --reopt (repetable, dans l'ordre)
+  string checkpointFile;     // --checkpoint
+  string resumeFile;         // --resume
+  for (size_t i = 1; i < args.size(); ++i) {  const string &arg = args[i];
     if (arg == "--summary"){
       summary = true;
     }
+    else if (arg == "--json"){
+      json = true;
+    }
+    else if (arg == "--trace"){
+      trace = true;
+    }
+    else if (arg == "--directed"){
+      directed = true;
+    }
+    else if (arg == "--tour"){
+      tour = true;
+    }
+    else if (arg == "--dump-points" && i + 1 < args.size()){
+      pointsFile = args[++i];
+    }
+    else if (arg == "--threads" && i + 1 < args.size()){
+      params.threads = atoi(args[++i].c_str());
+      if (params.threads < 0) {
+        cerr << "--threads doit etre >= 0" << endl;
+        return 1;
+      }
+    }
+    else if (arg == "--seed-2cycles"){
+      params.seedTwoCycles = true;
+    }
+    else if (arg == "--seed-triangles" && i + 1 < args.size()){
+      params.seedTriangles = atoi(args[++i].c_str());
+    }
+    else if (arg == "--held-karp-max" && i + 1 < args.size()){
+      params.heldKarpMax = atoi(args[++i].c_str());
+      if (params.heldKarpMax < 0 || params.heldKarpMax > ATSP_HeldKarp::MAX_N) {
+        cerr << "--held-karp-max doit etre dans [0, " << ATSP_HeldKarp::MAX_N << "]" << endl;
+        return 1;
+      }
+    }
+    else if (arg == "--arc-elim"){
+      params.arcElim = true;
+    }
+    else if (arg == "--tail-off" && i + 1 < args.size()){
+      params.tailOff = atof(args[++i].c_str());
+      if (params.tailOff <= 0.0) {
+        cerr << "--tail-off doit etre > 0" << endl;
+        return 1;
+      }
+    }
+    else if (arg == "--checkpoint" && i + 1 < args.size()){
+      checkpointFile = args[++i];
+    }
+    else if (arg == "--checkpoint-every" && i + 1 < args.size()){
+      params.checkpointEvery = atof(args[++i].c_str());
+      if (params.checkpointEvery <= 0.0) {
+        cerr << "--checkpoint-every doit etre > 0" << endl;
+        return 1;
+      }
+    }
+    else if (arg == "--resume" && i + 1 < args.size()){
+      resumeFile = args[++i];
+    }
+    else if (arg == "--reopt" && i + 1 < args.size()){
+      reoptFiles.push_back(args[++i]);
+    }
+    else if (arg == "--mem-budget" && i + 1 < args.size()){
+      memBudget = atof(args[++i].c_str());
+    }
+    else if (arg == "--time-limit" && i + 1 < args.size()){
+      params.timeLimit = atof(args[++i].c_str());
+      if (params.timeLimit <= 0.0) {
+        cerr << "--time-limit doit etre > 0" << endl;
+        return 1;
+      }
+    }
     else {
       mode = arg;
     }
   }
 
+  // pre-vol memoire : entete seulement (pas de matrice n x n allouee) ; --serve : instance deja en memoire
+  ATSPDataC data = inst ? *inst : ATSPDataC(path, LoadMode::Header);
+  if (data.size <= 0) {
+    cerr << "Lecture impossible : " << path << endl;
+    return 1;
+  }
+  const int headerSize = data.size;
+  const bool headerSymmetric = data.symmetric;
+
+  // AUTO : instance lue d'avance (caracteristiques) => mode + reglages de la table de regles, journal sur cerr
+  long long parseNs = inst ? instParseNs : 0;
+  bool loaded = (inst != nullptr);
+  string autoRule;
+  LagrangianBound lagr;
+  if (mode == "AUTO") {
+    if (!loaded) {
+      long long parseStart = nowNs();
+      data = ATSPDataC(path);
+      parseNs = nowNs() - parseStart;
+      loaded = true;
+    }
+    if (data.size <= 0) {
+      cerr << "Lecture impossible : " << path << endl;
+      return 1;
+    }
+
+    InstanceFeatures features = instanceFeatures(data);
+    AutoChoice choice = chooseMode(features, params);
+    cerr << describeChoice(features, choice) << endl;
+    mode = choice.mode;
+    params = choice.params;
+    autoRule = choice.rule;
+    if (features.hasBound) {
+      lagr = features.bound;
+    }
+  }
+
+  bool isCut = (mode == "CUT" || mode == "CUT_INT");
+  bool isCutLP = (mode == "CUT_LP" || mode == "CUT_Q");
+  bool isHybrid = (mode == "CUT_HYBRID"); // toujours le modele oriente (boucle racine + callback de ATSP_CUT)
+  bool symModel = headerSymmetric && !directed && (isCut || isCutLP);
+  ModelSize est = estimateModelSize(headerSize, mode, symModel, params.threads);
+
+  // hors budget : MTZ -> MTZ_LAZY, CUT oriente -> arcs candidats, sinon refus
+  if (memBudget > 0.0 && est.memMB > memBudget) {
+    cerr << "Estimation " << est.memMB << " Mo > budget " << memBudget << " Mo (" << est.vars << " vars, "
+         << est.rows << " lignes, " << est.nnz << " non nuls)" << endl;
+    if (mode == "MTZ" && estimateModelSize(headerSize, "MTZ_LAZY", false, params.threads).memMB <= memBudget) {
+      mode = "MTZ_LAZY";
+    }
+    else if ((isCut || isCutLP || isHybrid) && !symModel) {
+      for (int k : {20, 10, 5}) {
+        if (estimateModelSize(headerSize, mode, false, params.threads, k).memMB <= memBudget) {
+          params.candidateK = k;
+          break;
+        }
+      }
+    }
+
+    if (mode == "MTZ_LAZY" || params.candidateK > 0) {
+      est = estimateModelSize(headerSize, mode, symModel, params.threads, params.candidateK);
+      cerr << "=> " << mode << (params.candidateK > 0 ? " arcs candidats k=" + to_string(params.candidateK) : string(""))
+           << " (" << est.memMB << " Mo)" << endl;
+    }
+    else {
+      cerr << "Refus : aucun modele ne tient dans le budget" << endl;
+      return 3;
+    }
+  }
+
+  // lecture instance (temps mesure pour le RESULT)
+  if (!loaded) {
+    long long parseStart = nowNs();
+    data = ATSPDataC(path);
+    parseNs = nowNs() - parseStart;
+  }
+
+  if (data.size <= 0) {
+    cerr << "Lecture impossible : " << path << endl;
+    return 1;
+  }
+
+  // lots --reopt lus avant le solve (erreur de format => pas de solve)
+  vector<vector<ArcCost>> reopt;
+  for (const string &f : reoptFiles) {
+    reopt.emplace_back();
+    if (!readArcCosts(f, data.size, reopt.back())) {
+      cerr << "Lecture impossible : " << f << endl;
+      return 1;
+    }
+  }
+  if (!reopt.empty() && (mode == "BOUND" || data.size <= params.heldKarpMax || (data.symmetric && !directed && (isCut || isCutLP)))) {
+    cerr << "--reopt ignore : modeles ATSP_CUT / ATSP_MTZ seulement (pas BOUND, Held-Karp, ni STSP_CUT)" << endl;
+  }
+  // ATSP_CUT restreint (--arc-elim, arcs candidats, AUTO) : arcs absents choisis d'apres les anciens couts
+  // => re-solve sans eux faux ; ATSP_MTZ les rend au modele (reoptimize)
+  else if (!reopt.empty() && (isCut || isCutLP || isHybrid) && (params.arcElim || params.candidateK > 0)) {
+    cerr << "--reopt ignore : CUT / CUT_LP / CUT_HYBRID avec --arc-elim ou arcs candidats (--mem-budget)" << endl;
+    reopt.clear();
+  }
+
+  // --resume : meme instance (taille + empreinte des couts) sinon refus ; fichier absent == 1ere tranche
+  Checkpoint resume;
+  if (!resumeFile.empty() && !ifstream(resumeFile)) {
+    cerr << "Pas de point de reprise " << resumeFile << " : depart de zero" << endl;
+  }
+  else if (!resumeFile.empty()) {
+    if (!readCheckpoint(resumeFile, resume)) {
+      cerr << "Point de reprise illisible : " << resumeFile << endl;
+      return 1;
+    }
+    if (resume.n != data.size || resume.fingerprint != instanceFingerprint(data)) {
+      cerr << "Point de reprise d'une autre instance : " << resumeFile << " (" << resume.instance << ", n=" << resume.n << ")" << endl;
+      return 1;
+    }
+    cerr << "Reprise " << resumeFile << " : " << resume.subtours.size() << " sous tours + " << resume.lifted.size()
+         << " D_k, tour " << (resume.tourCost >= 0 ? to_string(resume.tourCost) : string("NA")) << ", borne "
+         << (resume.hasBound ? to_string(resume.bound) : string("NA")) << ", " << resume.elapsed << " s deja passees" << endl;
+  }
+  bool cutModel = (isCut || isCutLP || isHybrid) && data.size > params.heldKarpMax && !(data.symmetric && !directed && (isCut || isCutLP));
+  if ((!checkpointFile.empty() || !resumeFile.empty()) && !cutModel) {
+    cerr << "--checkpoint / --resume ignores : modeles ATSP_CUT seulement (CUT, CUT_LP, CUT_HYBRID orientes)" << endl;
+  }
+
+  // borne 1-arborescence seule (pas de LP) : obj == meilleur tour trouve, bound == borne arrondie
+  if (mode == "BOUND") {
+    LagrangianBound lb = lagr.empty() ? arborescenceBound(data) : lagr;
+    SolveStats stats;
+    stats.parseNs = parseNs;
+    stats.autoRule = autoRule;
+    stats.estMemMB = est.memMB;
+    stats.lagrNs = lb.ns;
+    stats.lagrBound = lb.bound;
+    reducedCostArcs(lb, data.size, stats.arcsEliminated);
+
+    if (summary || json || trace) {
+      SolveSummary s;
+      s.hasObj = s.hasBound = s.hasTime = true;
+      s.obj = static_cast<double>(lb.upper);
+      s.bound = ceil(lb.bound - 1e-6);
+      s.runtime = nsToSec(lb.ns);
+      s.status = lb.optimal ? "OPT" : "BOUND";
+      s.solver = "arborescence";
+      printSummary(instance, mode, s, 0, stats, summary, json, trace);
+    }
+    else {
+      cout << "Borne 1-arborescence : " << lb.bound << " (" << lb.iterations << " iterations, "
+           << nsToSec(lb.ns) << " seconds)" << endl;
+      cout << "Meilleur tour : " << lb.upper << (lb.optimal ? " (optimal)" : "") << endl;
+      cout << "Arcs elimines : " << stats.arcsEliminated << " / " << static_cast<long long>(data.size) * (data.size - 1) << endl;
+    }
+    if (tour) {
+      printTour(lb.tour);
+    }
+    return 0;
+  }
+
+  // --arc-elim (modeles orientes) : borne calculee avant la construction, passee au solveur
+  bool directedModel = !(data.symmetric && !directed && (isCut || isCutLP));
+  if (params.arcElim && directedModel && data.size > params.heldKarpMax && lagr.empty()) {
+    lagr = arborescenceBound(data);
+  }
+
+  // petite instance : Held-Karp exact (tous les modes) => ni environnement ni modele Gurobi
+  // CUT_LP : borne == optimum entier (>= borne LP)
+  if (data.size <= params.heldKarpMax) {
+    ATSP_HeldKarp solver(data);
+    solver.getterStats().parseNs = parseNs;
+    solver.getterStats().autoRule = autoRule;
+    solver.getterStats().estMemMB = est.memMB;
+    solver.setterParams(params);
+    solver.solve();
+
+    string shownMode = isCut ? "CUT" : (isCutLP ? "CUT_LP" : mode);
+    if (summary || json || trace) {
+      SolveSummary s;
+      s.hasObj = s.hasBound = s.hasTime = s.hasNodes = solver.getterSolved();
+      s.obj = s.bound = static_cast<double>(solver.getterCost());
+      s.runtime = nsToSec(solver.getterStats().optimizeNs);
+      s.status = solver.getterSolved() ? "OPT" : "NA";
+      s.solver = "held_karp";
+      printSummary(instance, shownMode, s, 0, solver.getterStats(), summary, json, trace);
+    }
+    else {
+      solver.printSolution();
+    }
+    if (tour) {
+      printTour(solver.getterTour());
+    }
+    return 0;
+  }
+
+  // TSP symetrique => modele aretes n(n-1)/2 (CUT / CUT_LP)
+  if (data.symmetric && !directed && (isCut || isCutLP)) {
+    STSP_CUT solver(data, isCut ? STSP_CUT::SolveMode::IntegerMIP : STSP_CUT::SolveMode::FractionalLP);
+    solver.getterStats().parseNs = parseNs;
+    solver.getterStats().autoRule = autoRule;
+    solver.getterStats().estMemMB = est.memMB;
+    solver.setterParams(params);
+    solver.setterEnv(env);
+    solver.solve();
+
+    if ((summary || json || trace) && solver.getterModel())
+      printSummary(instance, isCut ? "CUT" : "CUT_LP", *solver.getterModel(), solver.getterStatus(), solver.getTotalCuts(), solver.getterStats(), summary, json, trace);
+    if (tour) {
+      printTour(solver.getterTour());
+    }
+
+    return 0;
+  }
+
   // Mode CUT sol entier
-  if (mode == "CUT" || mode == "CUT_INT") {
-    ATSPDataC data(argv[1]);
+  if (isCut) {
     ATSP_CUT solver(data, ATSP_CUT::SolveMode::IntegerMIP);
+    solver.getterStats().lagrNs = lagr.ns;
+    solver.getterStats().lagrBound = lagr.bound;
+    solver.setterLagrangian(lagr);
+    solver.getterStats().parseNs = parseNs;
+    solver.getterStats().autoRule = autoRule;
+    solver.getterStats().estMemMB = est.memMB;
+    solver.setterParams(params);
+    solver.setterCheckpointFile(checkpointFile);
+    if (resume.n > 0) {
+      solver.setterResume(resume);
+    }
+    solver.setterEnv(env);
     solver.solve();
 
-    if (summary && solver.getterModel())
-      printSummary(baseName(argv[1]), "CUT", *solver.getterModel(), solver.getterStatus(), solver.getTotalCuts());
+    if ((summary || json || trace) && solver.getterModel())
+      printSummary(instance, "CUT", *solver.getterModel(), solver.getterStatus(), solver.getTotalCuts(), solver.getterStats(), summary, json, trace);
+    if (tour) {
+      printTour(solver.getterTour());
+    }
+    runReopt(solver, reopt, instance, "CUT", summary, json, trace, tour);
+
+    return 0;
+  }
+
+  // Mode CUT hybride : boucle de coupes racine (CUT_LP) puis branch-and-cut (CUT) sur le meme modele
+  if (isHybrid) {
+    ATSP_CUT solver(data, ATSP_CUT::SolveMode::Hybrid);
+    solver.getterStats().lagrNs = lagr.ns;
+    solver.getterStats().lagrBound = lagr.bound;
+    solver.setterLagrangian(lagr);
+    solver.getterStats().parseNs = parseNs;
+    solver.getterStats().autoRule = autoRule;
+    solver.getterStats().estMemMB = est.memMB;
+    solver.setterParams(params);
+    solver.setterPointsFile(pointsFile);
+    solver.setterCheckpointFile(checkpointFile);
+    if (resume.n > 0) {
+      solver.setterResume(resume);
+    }
+    solver.setterEnv(env);
+    solver.solve();
+
+    if ((summary || json || trace) && solver.getterModel())
+      printSummary(instance, "CUT_HYBRID", *solver.getterModel(), solver.getterStatus(), solver.getTotalCuts(), solver.getterStats(), summary, json, trace);
+    if (tour) {
+      printTour(solver.getterTour());
+    }
+    runReopt(solver, reopt, instance, "CUT_HYBRID", summary, json, trace, tour);
 
     return 0;
   }
 
   // Mode CUT sol frac
-  if (mode == "CUT_LP" || mode == "CUT_Q") {
-    ATSPDataC data(argv[1]);
+  if (isCutLP) {
     ATSP_CUT solver(data, ATSP_CUT::SolveMode::FractionalLP);
+    solver.getterStats().lagrNs = lagr.ns;
+    solver.getterStats().lagrBound = lagr.bound;
+    solver.setterLagrangian(lagr);
+    solver.getterStats().parseNs = parseNs;
+    solver.getterStats().autoRule = autoRule;
+    solver.getterStats().estMemMB = est.memMB;
+    solver.setterParams(params);
+    solver.setterPointsFile(pointsFile);
+    solver.setterCheckpointFile(checkpointFile);
+    if (resume.n > 0) {
+      solver.setterResume(resume);
+    }
+    solver.setterEnv(env);
     solver.solve();
 
-    if (summary && solver.getterModel()) {
-      printSummary(baseName(argv[1]), "CUT_LP", *solver.getterModel(), solver.getterStatus(), solver.getTotalCuts());
+    if ((summary || json || trace) && solver.getterModel()) {
+      printSummary(instance, "CUT_LP", *solver.getterModel(), solver.getterStatus(), solver.getTotalCuts(), solver.getterStats(), summary, json, trace);
 } 
+    if (tour) {
+      printTour(solver.getterTour());
+    }
+    runReopt(solver, reopt, instance, "CUT_LP", summary, json, trace, tour);
 
     return 0;
   }
 
-  // MTZ 
-  ATSPDataC data(argv[1]);
-  ATSP_MTZ solver(data);
+  // MTZ (MTZ_LAZY == contraintes MTZ separees dans le callback)
+  bool isMTZLazy = (mode == "MTZ_LAZY");
+  ATSP_MTZ solver(data, isMTZLazy ? ATSP_MTZ::Formulation::Lazy : ATSP_MTZ::Formulation::Full);
+  solver.getterStats().lagrNs = lagr.ns;
+  solver.getterStats().lagrBound = lagr.bound;
+  solver.setterLagrangian(lagr);
+  solver.getterStats().parseNs = parseNs;
+  solver.getterStats().autoRule = autoRule;
+  solver.getterStats().estMemMB = est.memMB;
+  solver.setterParams(params);
+  solver.setterEnv(env);
   solver.solve();
 
-  if (summary && solver.getterModel()) {
-    printSummary(baseName(argv[1]), "MTZ", *solver.getterModel(), solver.getterStatus(), 0);
+  if ((summary || json || trace) && solver.getterModel()) {
+    printSummary(instance, isMTZLazy ? "MTZ_LAZY" : "MTZ", *solver.getterModel(), solver.getterStatus(), solver.getTotalCuts(), solver.getterStats(), summary, json, trace);
   }
   else {
     solver.printSolution();
   }
+  if (tour) {
+    printTour(solver.getterTour());
+  }
+  runReopt(solver, reopt, instance, isMTZLazy ? "MTZ_LAZY" : "MTZ", summary, json, trace, tour);
 
   return 0;
 }
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    cout << "usage : " << argv[0] << " ATSPFilename [MTZ|MTZ_LAZY|CUT|CUT_LP|CUT_HYBRID|BOUND|AUTO] [--summary] [--json] [--trace] [--tour] [--dump-points FILE] [--directed] [--threads N] [--time-limit SEC] [--seed-2cycles] [--seed-triangles K] [--mem-budget MB] [--held-karp-max N] [--arc-elim] [--tail-off REL] [--reopt FILE]... [--checkpoint FILE] [--checkpoint-every SEC] [--resume FILE]" << endl;
+    cout << "        " << argv[0] << " --serve [SOCKET] [--cache N]   (requetes sur SOCKET ou stdin, cf. ATSP_Server.hpp)" << endl;
+    return 0;
+  }
+
+  // serveur : 1 environnement Gurobi pour toutes les requetes, reponses --summary --tour par defaut
+  if (string(argv[1]) == "--serve") {
+    ServerOptions options;
+    for (int i = 2; i < argc; ++i) {
+      string arg = argv[i];
+      if (arg == "--cache" && i + 1 < argc) {
+        options.cacheMax = static_cast<size_t>(max(0, atoi(argv[++i])));
+      }
+      else {
+        options.socketPath = arg;
+      }
+    }
+
+    shared_ptr<GRBEnv> env;
+    try {
+      env = make_shared<GRBEnv>(true);
+      env->set("LogFile", "tsp_server.log");
+      env->set(GRB_IntParam_LogToConsole, 0); // stdout == reponses
+      env->start();
+    }
+    catch (GRBException e) {
+      cerr << "Environnement Gurobi : " << e.getMessage() << endl;
+      return 1;
+    }
+
+    return serve(options, [&](const vector<string> &request, const ATSPDataC &data, long long parseNs) {
+      vector<string> args = request;
+      if (find(args.begin(), args.end(), "--summary") == args.end() && find(args.begin(), args.end(), "--json") == args.end()) {
+        args.push_back("--summary");
+      }
+      if (find(args.begin(), args.end(), "--tour") == args.end()) {
+        args.push_back("--tour");
+      }
+      return runSolve(args, &data, parseNs, env);
+    });
+  }
+
+  return runSolve(vector<string>(argv + 1, argv + argc), nullptr, 0, nullptr);
+}